@@ -0,0 +1,565 @@
+/*
+File Name:  ActorListLoader.cpp
+Author:     Logan Petersen
+Date:       Febuary 2, 2020
+Purpose:    The purpose of this code is to be the function definitions for
+            the prototypes in ActorListLoader.h. Parsing is the only part done
+            per chunk; the edges are built in parallel later by Graph::Finalize.
+            Streamed text is read through zlib, which passes text that is not
+            gzip through unchanged, unless NO_ZLIB is defined.
+*/
+
+#include "ActorListLoader.h"
+#include "ActorListParser.h" //Grants the parser run over each chunk.
+#include "Parallel.h"        //Grants ParallelFor, which runs the chunks on their threads.
+#include <cctype>            //Grants isalpha, which finds the name that starts a chunk.
+#include <cstring>           //Grants memchr, which finds the newlines of blank lines.
+#include <algorithm>         //Grants max, which keeps the chunks in order.
+#include "BoundedQueue.h"    //Grants BoundedQueue, which joins the stages of a stream.
+#include <chrono>            //Grants steady_clock, which times the stages of a stream.
+#include <memory>            //Grants unique_ptr, which keeps each queue of a stream in one place.
+#include <string>            //Grants string, for the path "-" that names standard input.
+#include <thread>            //Grants thread, which each stage of a stream runs on.
+#ifdef NO_ZLIB
+#include <cstdio>            //Grants fopen and fread, which read the stream.
+#else
+#include <zlib.h>            //Grants gzread, which reads the stream and decompresses it if it is gzip.
+#include <unistd.h>          //Grants dup, so closing the stream leaves standard input open.
+#endif
+
+namespace {
+
+   constexpr std::size_t StreamBlockBytes = 1 << 22; //The bytes read into each block of a stream before it is cut.
+   constexpr std::size_t StreamQueueBlocks = 2;      //The blocks each queue of a stream holds.
+
+   //The entries of one chunk, with the movies of every entry stored one after another.
+   struct ParsedChunk {
+      std::vector<std::string_view> names;  //The name of each entry.
+      std::vector<std::size_t> movieEnds;   //Where each entry's movies end in movies.
+      std::vector<std::string_view> movies; //The movies of every entry.
+   };
+
+   //A block of a stream, from when it is read until its entries are in the Graph.
+   struct StreamBlock {
+      std::vector<char> text; //The text, cut after the last blank line before an entry.
+      ParsedChunk entries;    //The entries parsed from text, which point into it.
+   };
+
+   //Where a stream is read from: a file or standard input, decompressed if it is gzip.
+   class StreamSource {
+   public:
+      /*
+      Purpose:          Construct the StreamSource with nothing open.
+      Parameters:       None.
+      Preconditions:    This specific StreamSource object has not been instantiated.
+      Postconditions:   StreamSource object has been instantiated with nothing open.
+      Return value:     None.
+      Functions Called: None.
+      */
+      StreamSource() : failed(false), input(nullptr) {}
+
+      /*
+      Purpose:          Close whatever is open.
+      Parameters:       None.
+      Preconditions:    This specific StreamSource object has left scope and is slated for deletion.
+      Postconditions:   Nothing is open.
+      Return value:     None.
+      Functions Called: None.
+      */
+      ~StreamSource() {
+         if (input != nullptr) {
+#ifdef NO_ZLIB
+            if (input != stdin) {
+               std::fclose(input);
+            }
+#else
+            gzclose(input);
+#endif
+         }
+      }
+
+      StreamSource(const StreamSource&) = delete;
+      StreamSource& operator=(const StreamSource&) = delete;
+
+      /*
+      Purpose:          Open a file, or standard input.
+      Parameters:       path, the location of the file, or "-" for standard input.
+      Preconditions:    Nothing is open.
+      Postconditions:   The stream is ready to be read, if it could be opened.
+      Return value:     True if it was opened, false otherwise.
+      Functions Called: None.
+      */
+      bool Open(const char* path) {
+#ifdef NO_ZLIB
+         input = std::string(path) == "-" ? stdin : std::fopen(path, "rb");
+#else
+         input = std::string(path) == "-" ? gzdopen(dup(0), "rb") : gzopen(path, "rb");
+         if (input != nullptr) {
+            gzbuffer(input, 1 << 17);
+         }
+#endif
+         return input != nullptr;
+      }
+
+      /*
+      Purpose:          Read the next bytes of the stream, decompressed.
+      Parameters:       buffer, where they are written.
+                        size, the most bytes read.
+      Preconditions:    The stream is open.
+      Postconditions:   The bytes read are in buffer. Failed() is true if the stream could not be read past them.
+      Return value:     The number of bytes read, which is 0 at the end of the stream or once it has failed.
+      Functions Called: None.
+      */
+      std::size_t Read(char* buffer, std::size_t size) {
+#ifdef NO_ZLIB
+         std::size_t count = std::fread(buffer, 1, size, input);
+
+         if (std::ferror(input)) {
+            failed = true;
+         }
+
+         //Without zlib, gzip would be parsed as text, so it is refused by the two bytes every gzip file starts with.
+         if (!started && count >= 2 && static_cast<unsigned char>(buffer[0]) == 0x1F &&
+             static_cast<unsigned char>(buffer[1]) == 0x8B) {
+            failed = true;
+            return 0;
+         }
+         started = true;
+         return count;
+#else
+         int count = gzread(input, buffer, static_cast<unsigned>(size));
+         int error = Z_OK;
+
+         //A gzip file cut short only says so once its last bytes have been read, which are still good text.
+         gzerror(input, &error);
+         if (count < 0 || error != Z_OK) {
+            failed = true;
+         }
+         return count > 0 ? static_cast<std::size_t>(count) : 0;
+#endif
+      }
+
+      /*
+      Purpose:          Give whether the stream could not be read to its end, such as a gzip file that is cut short or
+                        corrupt. Without zlib a gzip file cannot be read at all.
+      Parameters:       None.
+      Preconditions:    None.
+      Postconditions:   Nothing changes.
+      Return value:     True once a read has failed, false otherwise.
+      Functions Called: None.
+      */
+      bool Failed() const {
+         return failed;
+      }
+   private:
+      bool failed;          //True once a read has failed.
+#ifdef NO_ZLIB
+      std::FILE* input;     //The file, or stdin.
+      bool started = false; //True once the first bytes have been read.
+#else
+      gzFile input;         //The file or standard input, read through zlib.
+#endif
+   };
+
+   /*
+   Purpose:          Give the seconds since a time.
+   Parameters:       start, the time.
+   Preconditions:    None.
+   Postconditions:   Nothing changes.
+   Return value:     The seconds from start until now.
+   Functions Called: None.
+   */
+   double SecondsSince(std::chrono::steady_clock::time_point start) {
+      return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+   }
+
+   /*
+   Purpose:          Find the first actor/actress entry that starts after a blank line at or after position.
+   Parameters:       position, where to start looking.
+                     end, one past the last byte of the text.
+   Preconditions:    position is at or before end.
+   Postconditions:   Nothing changes.
+   Return value:     The first letter after a blank line whose line also holds the tab ending a name, or end if
+                     there is none. This is where a reader would be after the entry before it.
+   Functions Called: None.
+   */
+   char* FindEntryStart(char* position, char* end) {
+      while (position != end) {
+         //The text has not ended and no entry has been found.
+
+         char* newline = static_cast<char*>(std::memchr(position, '\n', static_cast<std::size_t>(end - position)));
+         char* lineEnd;
+
+         if (newline == nullptr || newline + 1 == end) {
+            return end;
+         }
+         position = newline + 1;
+         if (*position != '\n') {
+            continue;
+         }
+
+         //Put the start on the next name, the same way a reader skips to it after an entry.
+         while (position != end && !std::isalpha(static_cast<unsigned char>(*position))) {
+            //Text has not ended and the next character is not a letter of the alphabet.
+
+            position++;
+         }
+
+         //An entry's first line has a tab after the name. Without one a reader would still be reading a name here.
+         lineEnd = static_cast<char*>(std::memchr(position, '\n', static_cast<std::size_t>(end - position)));
+         if (lineEnd == nullptr) {
+            lineEnd = end;
+         }
+         if (std::memchr(position, '\t', static_cast<std::size_t>(lineEnd - position)) != nullptr) {
+            return position;
+         }
+      }
+      return end;
+   }
+
+   /*
+   Purpose:          Find an actor/actress entry that starts after a blank line near the end of some text, so that the
+                     text before it can be parsed without the text after it.
+   Parameters:       begin, the first byte of the text.
+                     end, one past the last byte of the text.
+   Preconditions:    None.
+   Postconditions:   Nothing changes.
+   Return value:     An entry start after begin, as FindEntryStart gives them, or begin if there is none.
+   Functions Called: FindEntryStart(), which looks for the start in ever larger tails of the text.
+   */
+   char* FindLastEntryStart(char* begin, char* end) {
+
+      //Local Variables
+      std::size_t tail = 1 << 16; //The bytes at the end of the text looked through.
+
+      while (end - begin > 1) {
+         //No entry start has been found, and the text before the tail has not all been looked through.
+
+         char* position = static_cast<std::size_t>(end - begin - 1) > tail ? end - tail : begin + 1;
+         char* start = FindEntryStart(position, end);
+         if (start != end) {
+            return start;
+         }
+         if (position == begin + 1) {
+            break;
+         }
+         tail *= 4;
+      }
+      return begin;
+   }
+
+   /*
+   Purpose:          Parse every entry of a chunk.
+   Parameters:       begin, the first byte of the chunk, which must be writable.
+                     end, one past the last byte of the chunk.
+                     chunk, the entries found are added to the end of it.
+   Preconditions:    begin starts an entry.
+   Postconditions:   chunk holds every entry in the text, in the order they appear.
+   Return value:     None.
+   Functions Called: ActorListParser::Next(), which reads each entry.
+   */
+   void ParseChunk(char* begin, char* end, ParsedChunk& chunk) {
+
+      //Local Variables
+      ActorListParser parser(begin, end);
+      std::string_view name;
+      std::vector<std::string_view> movies;
+
+      while (parser.Next(name, movies)) {
+         //The chunk has more actor/actress entries.
+
+         chunk.names.push_back(name);
+         chunk.movies.insert(chunk.movies.end(), movies.begin(), movies.end());
+         chunk.movieEnds.push_back(chunk.movies.size());
+      }
+   }
+
+   /*
+   Purpose:          Add every entry of a parsed chunk to a Graph.
+   Parameters:       graph, the Graph the entries are added to.
+                     chunk, the entries.
+   Preconditions:    The text chunk was parsed from has not been released.
+   Postconditions:   graph contains every entry of chunk, added in order.
+   Return value:     None.
+   Functions Called: Graph::Add(), which adds each entry.
+   */
+   void AddChunk(Graph& graph, const ParsedChunk& chunk) {
+
+      //Local Variables
+      std::vector<std::string_view> movies;
+      std::size_t movieBegin = 0;
+
+      for (std::size_t entry = 0; entry < chunk.names.size(); entry++) {
+         //Every entry of this chunk has not been added yet.
+
+         movies.assign(chunk.movies.begin() + movieBegin, chunk.movies.begin() + chunk.movieEnds[entry]);
+         graph.Add(chunk.names[entry], movies);
+         movieBegin = chunk.movieEnds[entry];
+      }
+   }
+}
+
+/*
+Purpose:          Split actors list text into chunks that each start on an actor/actress entry.
+Parameters:       begin, the first byte of the text.
+                  end, one past the last byte of the text.
+                  count, the number of chunks wanted.
+Preconditions:    begin starts an entry.
+Postconditions:   Nothing changes.
+Return value:     The start of every chunk in order, beginning with begin and followed by end. Each later start is
+                  the first letter after a blank line, which is where a reader would be after the entry before it.
+                  Fewer chunks than count are returned when the text has too few blank lines.
+Functions Called: None.
+*/
+std::vector<char*> SplitActorList(char* begin, char* end, unsigned count) {
+
+   //Local Variables
+   std::vector<char*> starts;
+   std::size_t size = static_cast<std::size_t>(end - begin);
+
+   starts.push_back(begin);
+   for (unsigned chunk = 1; chunk < count; chunk++) {
+      //Every chunk after the first has not been given a start yet.
+
+      //Never go back into the chunk before.
+      char* position = std::max(begin + size * chunk / count, starts.back() + 1);
+
+      position = FindEntryStart(position, end);
+      if (position == end) {
+         break;
+      }
+      starts.push_back(position);
+   }
+   starts.push_back(end);
+   return starts;
+}
+
+/*
+Purpose:          Parse actors list text on several threads and add every entry to a Graph.
+Parameters:       graph, the Graph the entries are added to.
+                  begin, the first byte of the text, which must be writable.
+                  end, one past the last byte of the text.
+                  threadCount, the number of threads to parse with.
+Preconditions:    begin starts an entry, and the text outlives graph's use of it.
+Postconditions:   graph contains every entry in the text, added in the order the entries appear.
+Return value:     None.
+Functions Called: SplitActorList(), which chooses the chunks.
+                  ParallelFor(), which parses the chunks on threadCount threads.
+                  ActorListParser::Next(), which reads each entry of a chunk.
+                  Graph::Add(), which adds each entry to graph.
+                  PhaseTimer, which times the parsing and the adding when graph has RunStats.
+*/
+void LoadActorList(Graph& graph, char* begin, char* end, unsigned threadCount) {
+
+   //Local Variables
+   std::vector<char*> starts;
+   std::vector<ParsedChunk> chunks;
+   RunStats* stats = graph.Stats(); //Where the parsing and adding are recorded, or nullptr.
+
+   {
+      PhaseTimer timer(stats, "parse");
+
+      starts = SplitActorList(begin, end, threadCount);
+      chunks.resize(starts.size() - 1);
+
+      //Each thread parses its own chunks. A parser only writes inside the chunk it reads, so they never meet.
+      ParallelFor(chunks.size(), threadCount, [&starts, &chunks](std::size_t first, std::size_t last, std::size_t) {
+         for (std::size_t chunk = first; chunk < last; chunk++) {
+            //Every chunk of this thread has not been parsed yet.
+
+            ParseChunk(starts[chunk], starts[chunk + 1], chunks[chunk]);
+         }
+      });
+   }
+   if (RunStatsBuilt && stats != nullptr) {
+      stats->bytesParsed += static_cast<std::uint64_t>(end - begin);
+      for (const ParsedChunk& chunk : chunks) {
+         //Every chunk's entries have not been counted yet.
+
+         stats->entriesParsed += chunk.names.size();
+      }
+   }
+
+   //Adding in chunk order keeps every Vertex's id, and so the output, the same as a single reader.
+   PhaseTimer timer(stats, "add");
+   for (ParsedChunk& chunk : chunks) {
+      //Every chunk has not been added to the graph yet.
+
+      AddChunk(graph, chunk);
+
+      //The parsed chunk is no longer needed once it is in the graph.
+      chunk = ParsedChunk();
+   }
+}
+
+/*
+Purpose:          Read an actors list from a file or standard input, decompressing it if it is gzip, and add every
+                  entry to a Graph, with reading, parsing and adding each running on their own threads at once.
+Parameters:       graph, the Graph the entries are added to.
+                  path, the location of the file, or "-" for standard input.
+                  threadCount, the number of threads to use. At least three run: one reads, the rest but one parse,
+                  and the calling thread adds.
+Preconditions:    The text starts with an entry.
+Postconditions:   graph contains every entry read, added in the order the entries appear, which is every entry in
+                  the text unless it could not be read to its end.
+Return value:     True if the whole text was read, false if it could not be opened or read to its end.
+Functions Called: StreamSource::Read(), which reads and decompresses the text.
+                  FindLastEntryStart(), which cuts the text into blocks.
+                  ParseChunk(), which parses each block.
+                  AddChunk(), which adds each block's entries to graph.
+                  PhaseTimer, which times the whole stream when graph has RunStats.
+*/
+bool StreamActorList(Graph& graph, const char* path, unsigned threadCount) {
+
+   //Local Variables
+   StreamSource source;
+   std::size_t parserCount = threadCount > 3 ? threadCount - 2 : 1;
+   std::vector<std::unique_ptr<BoundedQueue<StreamBlock>>> toParse; //The blocks read, for each parser in turn.
+   std::vector<std::unique_ptr<BoundedQueue<StreamBlock>>> toAdd;   //The blocks each parser has parsed.
+   std::vector<std::thread> parsers;
+   std::vector<double> parseSeconds(parserCount, 0); //The time each parser spent parsing.
+   std::thread reader;
+   double readSeconds = 0;    //The time the reader spent reading and cutting blocks.
+   double addSeconds = 0;     //The time spent adding entries.
+   std::uint64_t bytes = 0;   //The bytes of text read.
+   std::uint64_t entries = 0; //The entries parsed from them.
+   RunStats* stats = graph.Stats(); //Where the stream is recorded, or nullptr.
+   bool timed = RunStatsBuilt && stats != nullptr;
+
+   if (!source.Open(path)) {
+      return false;
+   }
+   for (std::size_t i = 0; i < parserCount; i++) {
+      //Every parser has not been given its queues yet.
+
+      toParse.push_back(std::make_unique<BoundedQueue<StreamBlock>>(StreamQueueBlocks));
+      toAdd.push_back(std::make_unique<BoundedQueue<StreamBlock>>(StreamQueueBlocks));
+   }
+
+   {
+      PhaseTimer timer(stats, "stream");
+
+      //The reader deals the blocks out to the parsers in turn, so taking them back in the same turn keeps file order.
+      reader = std::thread([&source, &toParse, &readSeconds, &bytes, timed] {
+         std::vector<char> carried; //The text after the last cut, which starts the next block.
+         std::size_t next = 0;      //The parser the next block goes to.
+         bool ended = false;
+
+         while (!ended) {
+            //The stream has not ended.
+
+            std::chrono::steady_clock::time_point start;
+            StreamBlock block;
+            char* cut;
+
+            if (timed) {
+               start = std::chrono::steady_clock::now();
+            }
+            //A block carried over whole because no entry start was found in it still reads more.
+            block.text.swap(carried);
+            do {
+               //The block has room left, and the stream has not ended.
+
+               std::size_t used = block.text.size();
+               block.text.resize(used + StreamBlockBytes);
+               std::size_t count = source.Read(block.text.data() + used, StreamBlockBytes);
+
+               //The text read before a failure is kept, so every entry up to it is still added.
+               ended = count == 0 || source.Failed();
+               block.text.resize(used + count);
+               bytes += block.text.size() - used;
+            } while (!ended && block.text.size() < StreamBlockBytes);
+
+            //Everything left is parsed at the end. Otherwise the text after the last entry start that can be found
+            //waits for the next block, unless no start can be found, when the block keeps growing instead.
+            if (!ended) {
+               cut = FindLastEntryStart(block.text.data(), block.text.data() + block.text.size());
+               if (cut == block.text.data()) {
+                  carried.swap(block.text);
+                  continue;
+               }
+               carried.assign(cut, block.text.data() + block.text.size());
+               block.text.resize(static_cast<std::size_t>(cut - block.text.data()));
+            }
+            if (timed) {
+               readSeconds += SecondsSince(start);
+            }
+            if (!block.text.empty()) {
+               toParse[next]->Push(std::move(block));
+               next = (next + 1) % toParse.size();
+            }
+         }
+         for (std::unique_ptr<BoundedQueue<StreamBlock>>& queue : toParse) {
+            //Every parser has not been told the stream has ended yet.
+
+            queue->Close();
+         }
+      });
+
+      for (std::size_t i = 0; i < parserCount; i++) {
+         //Every parser has not been started yet.
+
+         parsers.emplace_back([&toParse, &toAdd, &parseSeconds, i, timed] {
+            StreamBlock block;
+
+            while (toParse[i]->Pop(block)) {
+               //The reader has more blocks for this parser.
+
+               std::chrono::steady_clock::time_point start;
+               if (timed) {
+                  start = std::chrono::steady_clock::now();
+               }
+               ParseChunk(block.text.data(), block.text.data() + block.text.size(), block.entries);
+               if (timed) {
+                  parseSeconds[i] += SecondsSince(start);
+               }
+               toAdd[i]->Push(std::move(block));
+            }
+            toAdd[i]->Close();
+         });
+      }
+
+      //The blocks are added on this thread in the order they were read, and each is released once it is in the graph.
+      for (std::size_t next = 0;; next = (next + 1) % parserCount) {
+         //The parsers have more blocks.
+
+         std::chrono::steady_clock::time_point start;
+         StreamBlock block;
+
+         if (!toAdd[next]->Pop(block)) {
+            break;
+         }
+         if (timed) {
+            start = std::chrono::steady_clock::now();
+         }
+         AddChunk(graph, block.entries);
+         entries += block.entries.names.size();
+         if (timed) {
+            addSeconds += SecondsSince(start);
+         }
+      }
+      reader.join();
+      for (std::thread& i : parsers) {
+         //Every parser has not been joined yet.
+
+         i.join();
+      }
+   }
+
+   //Each stage's own time, which the stream takes about the longest of when the stages overlap well.
+   if (timed) {
+      double parseTotal = 0;
+
+      for (double i : parseSeconds) {
+         //Every parser's time has not been added up yet.
+
+         parseTotal += i;
+      }
+      stats->bytesParsed += bytes;
+      stats->entriesParsed += entries;
+      stats->phases.push_back({"read", readSeconds});
+      stats->phases.push_back({"parse", parseTotal});
+      stats->phases.push_back({"add", addSeconds});
+   }
+   return !source.Failed();
+}
@@ -0,0 +1,75 @@
+/*
+File Name:  ActorListLoader.h
+Author:     Logan Petersen
+Date:       Febuary 2, 2020
+Purpose:    This is the header file for the loader that fills a Graph from an IMDB actors list
+            held in memory. The text is split into chunks at blank lines, since a blank line
+            ends every actor/actress entry, and each chunk is parsed on its own thread. The
+            entries are then added to the Graph in file order, so the Graph is the same as if
+            the text had been read by one ActorListParser from start to end.
+
+            StreamActorList reads the text from a file or standard input instead, decompressing it
+            on the way if it is gzip, such as the actors.list.gz IMDB ships. Reading, parsing and
+            adding each run on their own threads, joined by BoundedQueues: the reader cuts the text
+            into blocks of a few megabytes at blank lines before entries and deals them out to the
+            parsers in turn, and the calling thread takes them back in the same turn and adds them,
+            so the entries are added in file order. While one block is added the next ones are
+            being parsed and read, so loading takes about as long as the slowest of the three, and
+            only a few blocks are ever held at once. Building with NO_ZLIB defined reads the stream
+            without zlib, as text only.
+*/
+
+#pragma once
+
+#include "Graph.h"
+#include <vector> //Grants the vector the chunk boundaries are returned in.
+
+/*
+Purpose:          Split actors list text into chunks that each start on an actor/actress entry.
+Parameters:       begin, the first byte of the text.
+                  end, one past the last byte of the text.
+                  count, the number of chunks wanted.
+Preconditions:    begin starts an entry.
+Postconditions:   Nothing changes.
+Return value:     The start of every chunk in order, beginning with begin and followed by end. Each later start is
+                  the first letter after a blank line, which is where a reader would be after the entry before it.
+                  Fewer chunks than count are returned when the text has too few blank lines.
+Functions Called: None.
+*/
+std::vector<char*> SplitActorList(char* begin, char* end, unsigned count);
+
+/*
+Purpose:          Parse actors list text on several threads and add every entry to a Graph.
+Parameters:       graph, the Graph the entries are added to.
+                  begin, the first byte of the text, which must be writable.
+                  end, one past the last byte of the text.
+                  threadCount, the number of threads to parse with.
+Preconditions:    begin starts an entry, and the text outlives graph's use of it.
+Postconditions:   graph contains every entry in the text, added in the order the entries appear.
+Return value:     None.
+Functions Called: SplitActorList(), which chooses the chunks.
+                  ParallelFor(), which parses the chunks on threadCount threads.
+                  ActorListParser::Next(), which reads each entry of a chunk.
+                  Graph::Add(), which adds each entry to graph.
+                  PhaseTimer, which times the parsing and the adding when graph has RunStats.
+*/
+void LoadActorList(Graph& graph, char* begin, char* end, unsigned threadCount);
+
+/*
+Purpose:          Read an actors list from a file or standard input, decompressing it if it is gzip, and add every
+                  entry to a Graph, with reading, parsing and adding each running on their own threads at once.
+Parameters:       graph, the Graph the entries are added to.
+                  path, the location of the file, or "-" for standard input.
+                  threadCount, the number of threads to use. At least three run: one reads, the rest but one parse,
+                  and the calling thread adds.
+Preconditions:    The text starts with an entry.
+Postconditions:   graph contains every entry read, added in the order the entries appear, which is every entry in
+                  the text unless it could not be read to its end.
+Return value:     True if the whole text was read, false if it could not be opened or read to its end.
+Functions Called: StreamSource::Read(), which reads and decompresses the text.
+                  FindLastEntryStart(), which cuts the text into blocks.
+                  ParseChunk(), which parses each block.
+                  AddChunk(), which adds each block's entries to graph.
+                  PhaseTimer, which times the whole stream when graph has RunStats.
+*/
+bool StreamActorList(Graph& graph, const char* path, unsigned threadCount);
@@ -0,0 +1,322 @@
+/*
+File Name:  ActorListParser.cpp
+Author:     Logan Petersen
+Date:       Febuary 2, 2020
+Purpose:    The purpose of this code is to be the function definitions for
+            the prototypes in ActorListParser.h. The long runs of the text are
+            read without looking at each character: the name and the data inside
+            () and {} are skipped with memchr, the data inside <> and [] with
+            FindFirstOf, and the movie text up to the next bracket or newline is
+            copied by CopyRun, both of which check 8 bytes at a time.
+*/
+
+#include "ActorListParser.h"
+#include <cctype>  //Grants isdigit and isalpha, used to decide what is extraneous and where names start.
+#include <cstdio>  //Grants EOF, which is what peeking past the end of the buffer gives.
+#include <cstring> //Grants memchr and memcpy, used to find tabs and closing brackets and to move whole words.
+#include <cstdint> //Grants uint64_t, the 8 bytes checked at once.
+#include <string_view> //Grants string_view, which the sets of characters are written as.
+
+namespace {
+
+   //A set of characters, as the words MatchWord compares 8 bytes with and a table for single bytes.
+   struct CharacterSet {
+      std::uint64_t words[5];  //Each character of the set repeated in all 8 bytes.
+      int count;               //The number of characters in the set.
+      bool contains[256];      //True for each byte in the set.
+   };
+
+   /*
+   Purpose:          Build a CharacterSet.
+   Parameters:       characters, the characters of the set, at most 5.
+   Preconditions:    None.
+   Postconditions:   Nothing changes.
+   Return value:     The set.
+   Functions Called: None.
+   */
+   constexpr CharacterSet MakeSet(std::string_view characters) {
+
+      //Local Variables
+      CharacterSet set = {};
+
+      for (char i : characters) {
+         //Every character has not been added yet.
+
+         set.words[set.count++] = 0x0101010101010101 * static_cast<unsigned char>(i);
+         set.contains[static_cast<unsigned char>(i)] = true;
+      }
+      return set;
+   }
+
+   constexpr CharacterSet RunBreaks = MakeSet("({<[\n");        //The characters that end a run of plain movie text.
+   constexpr CharacterSet Dropped = MakeSet(" \t");             //The characters left out of movie names.
+   constexpr CharacterSet AngleOrSquareCloses = MakeSet(">]"); //Either ends a <> or [].
+
+   /*
+   Purpose:          Mark the bytes of a word that are in a set, comparing every byte with every character of the set at
+                     once with the usual test for a zero byte.
+   Parameters:       word, 8 bytes of text.
+                     set, the characters looked for.
+   Preconditions:    None.
+   Postconditions:   Nothing changes.
+   Return value:     0 if no byte of word is in the set. Otherwise the lowest marked byte is the first in the set, though
+                     bytes after it may be marked wrongly.
+   Functions Called: None.
+   */
+   inline std::uint64_t MatchWord(std::uint64_t word, const CharacterSet& set) {
+
+      //Local Variables
+      constexpr std::uint64_t Ones = 0x0101010101010101;
+      constexpr std::uint64_t Highs = 0x8080808080808080;
+      std::uint64_t found = 0;
+
+      for (int i = 0; i < set.count; i++) {
+         //Every character of the set has not been compared yet.
+
+         std::uint64_t difference = word ^ set.words[i];
+         found |= (difference - Ones) & ~difference & Highs;
+      }
+      return found;
+   }
+
+   /*
+   Purpose:          Find the first character of some text that is in a set, checking 8 bytes at a time, and only
+                     looking at the bytes of a word one at a time once it holds one.
+   Parameters:       from, the first byte of the text.
+                     to, one past the last byte of the text.
+                     set, the characters searched for.
+   Preconditions:    None.
+   Postconditions:   Nothing changes.
+   Return value:     The first byte in the set, or to if there is none.
+   Functions Called: MatchWord(), which checks each word.
+   */
+   inline char* FindFirstOf(char* from, char* to, const CharacterSet& set) {
+      while (to - from >= 8) {
+         //At least one whole word is left.
+
+         std::uint64_t word;
+         std::memcpy(&word, from, 8);
+         if (MatchWord(word, set) != 0) {
+            break;
+         }
+         from += 8;
+      }
+      for (; from != to; from++) {
+         //The last few bytes, or the word holding a match, have not been looked at yet.
+
+         if (set.contains[static_cast<unsigned char>(*from)]) {
+            return from;
+         }
+      }
+      return to;
+   }
+
+   /*
+   Purpose:          Copy plain movie text to where the movie name is being written, up to the next bracket or newline,
+                     leaving out spaces and tabs. A word of 8 bytes with none of those is copied whole, and one with
+                     spaces or tabs is packed down a byte at a time without branching.
+   Parameters:       from, the first byte of the text.
+                     to, one past the last byte of the text.
+                     write, where the first kept byte goes.
+                     stop, set to the bracket or newline that ended the text, or to.
+   Preconditions:    write is at or before from.
+   Postconditions:   The kept bytes before stop have been written.
+   Return value:     One past the last byte written.
+   Functions Called: MatchWord(), which checks each word.
+   */
+   inline char* CopyRun(char* from, char* to, char* write, char*& stop) {
+      while (to - from >= 8) {
+         //At least one whole word is left.
+
+         std::uint64_t word;
+         std::memcpy(&word, from, 8);
+         if (MatchWord(word, RunBreaks) != 0) {
+            break;
+         }
+
+         //Writing behind the word just read never reaches text that has not been read yet.
+         if (MatchWord(word, Dropped) == 0) {
+            std::memcpy(write, &word, 8);
+            write += 8;
+         }
+         else {
+            for (int i = 0; i < 8; i++) {
+               //Every byte of the word has not been copied yet.
+
+               *write = from[i];
+               write += !Dropped.contains[static_cast<unsigned char>(from[i])];
+            }
+         }
+         from += 8;
+      }
+      for (; from != to && !RunBreaks.contains[static_cast<unsigned char>(*from)]; from++) {
+         //The last few bytes, or the word holding the end of the text, have not been copied yet.
+
+         *write = *from;
+         write += !Dropped.contains[static_cast<unsigned char>(*from)];
+      }
+      stop = from;
+      return write;
+   }
+}
+
+/*
+Purpose:          Construct the parser over a buffer of actors list text.
+Parameters:       begin, the first byte of the text.
+                  end, one past the last byte of the text.
+Preconditions:    This specific ActorListParser object has not been instantiated, and begin starts an entry.
+Postconditions:   ActorListParser object has been instantiated, ready to read the first entry.
+Return value:     None.
+Functions Called: None.
+*/
+ActorListParser::ActorListParser(char* begin, char* end) : position(begin), end(end) {}
+
+/*
+Purpose:          Read the next actor/actress entry.
+Parameters:       name, set to the name of the actor/actress.
+                  movies, cleared and then filled with the distinct movies of the actor/actress in the order
+                  they are listed.
+Preconditions:    An ActorListParser object has been instantiated.
+Postconditions:   The parser is on the name of the following entry, or at the end of the buffer.
+Return value:     True if an entry was read, false once the buffer holds no more entries.
+Functions Called: None.
+*/
+bool ActorListParser::Next(std::string_view& name, std::vector<std::string_view>& movies) {
+
+   //Local Variables
+   char input;       //The character being looked at.
+   char* tab;        //The tab that ends the name.
+   char* write;      //Where the next character kept for a movie name is written.
+   char* movieStart; //Where the movie name being read was started.
+
+   //These stand in for get and peek on the file, with the buffer's end standing in for the end of the file.
+   auto get = [this](char& character) {
+      if (position == end) {
+         return false;
+      }
+      character = *position++;
+      return true;
+   };
+   auto peek = [this]() {
+      return position == end ? EOF : static_cast<unsigned char>(*position);
+   };
+
+   movies.clear();
+   if (position == end) {
+      return false;
+   }
+
+   //The name is everything up to the first tab. Without a tab there is no movie, and so no entry.
+   tab = static_cast<char*>(std::memchr(position, '\t', static_cast<std::size_t>(end - position)));
+   if (tab == nullptr) {
+      position = end;
+      return false;
+   }
+   name = std::string_view(position, static_cast<std::size_t>(tab - position));
+   position = tab;
+   write = tab;
+   movieStart = tab;
+
+   while (get(input)) {
+      //The buffer has not ended.
+
+      //Plain movie text, up to the next bracket or newline, only needs its spaces and tabs dropped. Only its last
+      //character can be followed by the end of a line, so only that one is looked at below.
+      if (!RunBreaks.contains[static_cast<unsigned char>(input)]) {
+         char* runEnd;
+
+         //The last character is taken back out, since it is written again below.
+         write = CopyRun(position - 1, end, write, runEnd);
+         position = runEnd;
+         input = runEnd[-1];
+         if (!Dropped.contains[static_cast<unsigned char>(input)]) {
+            write--;
+         }
+      }
+
+      //This covers the case of ()s.
+      if (input == '(' && !std::isdigit(peek())) {
+         char* close = static_cast<char*>(std::memchr(position, ')', static_cast<std::size_t>(end - position)));
+
+         //Whatever follows the closing parenthesis is looked at next. Running off the end leaves the last character read.
+         if (close != nullptr) {
+            position = close + 1;
+            input = ')';
+            get(input);
+         }
+         else if (position != end) {
+            input = end[-1];
+            position = end;
+         }
+      }
+
+      //This covers the case of {}.
+      if (input == '{') {
+         char* close = static_cast<char*>(std::memchr(position, '}', static_cast<std::size_t>(end - position)));
+
+         if (close != nullptr) {
+            position = close + 1;
+            input = '}';
+            get(input);
+         }
+         else if (position != end) {
+            input = end[-1];
+            position = end;
+         }
+      }
+
+      //This covers the case of <> and [], where either closing bracket ends either opening bracket.
+      if (input == '<' || input == '[') {
+         char* close = FindFirstOf(position, end, AngleOrSquareCloses);
+
+         if (close != end) {
+            position = close + 1;
+            input = *close;
+            get(input);
+         }
+         else if (position != end) {
+            input = end[-1];
+            position = end;
+         }
+      }
+
+      //This covers the case of spaces, and if not space then it is actually a movie.
+      //The kept character is written behind the read position, which is always at or past it.
+      if (input != '\n' && input != '\t' && input != ' ') {
+         *write++ = input;
+      }
+
+      //End of line for actor/actress.
+      if (peek() == EOF || (input == '\n' && write != movieStart && peek() == '\t') || peek() == '\n') {
+         std::string_view movie(movieStart, static_cast<std::size_t>(write - movieStart));
+
+         //If movie already exists, no need to duplicate it.
+         bool duplicate = false;
+         for (std::string_view i : movies) {
+            //Every movie already read for this actor/actress has not been iterated through yet.
+
+            if (i == movie) {
+               duplicate = true;
+               break;
+            }
+         }
+         if (!duplicate) {
+            movies.push_back(movie);
+         }
+         movieStart = write;
+      }
+
+      //End of actor/actress entry.
+      if (peek() == EOF || (input == '\n' && peek() == '\n')) {
+
+         //Put reader on the next name.
+         while (position != end && !std::isalpha(static_cast<unsigned char>(*position))) {
+            //Buffer has not ended and the next character is not a letter of the alphabet.
+
+            position++;
+         }
+         return true;
+      }
+   }
+   return false;
+}
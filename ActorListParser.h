@@ -0,0 +1,49 @@
+/*
+File Name:  ActorListParser.h
+Author:     Logan Petersen
+Date:       Febuary 2, 2020
+Purpose:    This is the header file for the ActorListParser class containing ActorListParser's interface.
+            ActorListParser reads actor/actress entries out of an IMDB actors list held in memory,
+            usually a MappedFile. It follows the same rules as the original character by character
+            reader: the name runs up to the first tab, and movie names drop spaces, tabs, newlines and
+            anything inside {}, <>, [] or ()s that do not start with a digit.
+
+            Names are returned as slices of the buffer. Movie names lose characters as they are
+            cleaned, so each cleaned movie name is written back over the bytes it was read from and
+            returned as a slice of those. The buffer must therefore be writable, and every slice stays
+            valid for as long as the buffer does.
+*/
+
+#pragma once
+
+#include <string_view> //Grants string_view, for the slices of the buffer that are returned.
+#include <vector>      //Grants the vector the movie names of an entry are returned in.
+
+class ActorListParser {
+public:
+   /*
+   Purpose:          Construct the parser over a buffer of actors list text.
+   Parameters:       begin, the first byte of the text.
+                     end, one past the last byte of the text.
+   Preconditions:    This specific ActorListParser object has not been instantiated, and begin starts an entry.
+   Postconditions:   ActorListParser object has been instantiated, ready to read the first entry.
+   Return value:     None.
+   Functions Called: None.
+   */
+   ActorListParser(char* begin, char* end);
+
+   /*
+   Purpose:          Read the next actor/actress entry.
+   Parameters:       name, set to the name of the actor/actress.
+                     movies, cleared and then filled with the distinct movies of the actor/actress in the order
+                     they are listed.
+   Preconditions:    An ActorListParser object has been instantiated.
+   Postconditions:   The parser is on the name of the following entry, or at the end of the buffer.
+   Return value:     True if an entry was read, false once the buffer holds no more entries.
+   Functions Called: None.
+   */
+   bool Next(std::string_view& name, std::vector<std::string_view>& movies);
+private:
+   char* position; //The next byte to be read.
+   char* end;      //One past the last byte of the buffer.
+};
@@ -0,0 +1,59 @@
+/*
+File Name:  ArrayView.h
+Author:     Logan Petersen
+Date:       Febuary 2, 2020
+Purpose:    This is the header file for the ArrayView class template. An ArrayView looks at an
+            array it does not own, so the frozen graph can be read the same way whether its arrays
+            live in vectors built by Graph::Finalize or in a mapped snapshot file.
+*/
+
+#pragma once
+
+#include <cstddef> //Grants size_t for the number of elements.
+#include <vector>  //Grants the vector an ArrayView can be made to look at.
+
+template <typename T>
+class ArrayView {
+public:
+   /*
+   Purpose:          Construct an ArrayView that looks at nothing.
+   Parameters:       None.
+   Preconditions:    This specific ArrayView object has not been instantiated.
+   Postconditions:   ArrayView object has been instantiated empty.
+   Return value:     None.
+   Functions Called: None.
+   */
+   ArrayView() : data(nullptr), count(0) {}
+
+   /*
+   Purpose:          Construct an ArrayView over an array.
+   Parameters:       first, the first element of the array.
+                     size, the number of elements in the array.
+   Preconditions:    This specific ArrayView object has not been instantiated.
+   Postconditions:   ArrayView object has been instantiated looking at the array.
+   Return value:     None.
+   Functions Called: None.
+   */
+   ArrayView(const T* first, std::size_t size) : data(first), count(size) {}
+
+   /*
+   Purpose:          Construct an ArrayView over the elements of a vector.
+   Parameters:       elements, the vector to look at, which must not grow while it is looked at.
+   Preconditions:    This specific ArrayView object has not been instantiated.
+   Postconditions:   ArrayView object has been instantiated looking at the vector's elements.
+   Return value:     None.
+   Functions Called: None.
+   */
+   ArrayView(const std::vector<T>& elements) : data(elements.data()), count(elements.size()) {}
+
+   //Element access, in the same form as a vector's.
+   const T& operator[](std::size_t index) const { return data[index]; }
+   const T* begin() const { return data; }
+   const T* end() const { return data + count; }
+   const T& back() const { return data[count - 1]; }
+   std::size_t size() const { return count; }
+   bool empty() const { return count == 0; }
+private:
+   const T* data;     //The first element looked at.
+   std::size_t count; //The number of elements looked at.
+};
@@ -0,0 +1,94 @@
+/*
+File Name:  BoundedQueue.h
+Author:     Logan Petersen
+Date:       Febuary 2, 2020
+Purpose:    This is the header file for BoundedQueue, which hands items from one thread to another
+            in the order they were pushed. It holds at most a fixed number of items, so a stage that
+            runs ahead of the one after it waits instead of filling memory. The stages that stream
+            an actors list, reading, parsing and adding to the Graph, are joined by BoundedQueues.
+*/
+
+#pragma once
+
+#include <condition_variable> //Grants condition_variable, which a thread waits on for room or for an item.
+#include <cstddef>            //Grants size_t for the capacity.
+#include <deque>              //Grants deque, which holds the items.
+#include <mutex>              //Grants mutex, which guards the items.
+#include <utility>            //Grants move, which hands an item over without copying it.
+
+template <typename T>
+class BoundedQueue {
+public:
+   /*
+   Purpose:          Construct an empty BoundedQueue.
+   Parameters:       capacity, the most items held at once. 0 is treated as 1.
+   Preconditions:    This specific BoundedQueue object has not been instantiated.
+   Postconditions:   BoundedQueue object has been instantiated, open and empty.
+   Return value:     None.
+   Functions Called: None.
+   */
+   explicit BoundedQueue(std::size_t capacity) : capacity(capacity == 0 ? 1 : capacity), closed(false) {}
+
+   //Threads wait on the queue itself, so it cannot be copied or moved out from under them.
+   BoundedQueue(const BoundedQueue&) = delete;
+   BoundedQueue& operator=(const BoundedQueue&) = delete;
+
+   /*
+   Purpose:          Add an item to the back of the queue, waiting while it is full.
+   Parameters:       item, the item, which is moved into the queue.
+   Preconditions:    A BoundedQueue object has been instantiated, and Close has not been called.
+   Postconditions:   item is at the back of the queue.
+   Return value:     None.
+   Functions Called: None.
+   */
+   void Push(T item) {
+      std::unique_lock<std::mutex> lock(mutex);
+
+      notFull.wait(lock, [this] { return items.size() < capacity; });
+      items.push_back(std::move(item));
+      notEmpty.notify_one();
+   }
+
+   /*
+   Purpose:          Take the item at the front of the queue, waiting while it is empty and still open.
+   Parameters:       item, set to the item taken.
+   Preconditions:    A BoundedQueue object has been instantiated.
+   Postconditions:   The item has left the queue, if there was one.
+   Return value:     True if an item was taken, false once the queue is closed and empty.
+   Functions Called: None.
+   */
+   bool Pop(T& item) {
+      std::unique_lock<std::mutex> lock(mutex);
+
+      notEmpty.wait(lock, [this] { return !items.empty() || closed; });
+      if (items.empty()) {
+         return false;
+      }
+      item = std::move(items.front());
+      items.pop_front();
+      notFull.notify_one();
+      return true;
+   }
+
+   /*
+   Purpose:          Mark that nothing more will be pushed.
+   Parameters:       None.
+   Preconditions:    A BoundedQueue object has been instantiated.
+   Postconditions:   Pop returns false once the items already pushed have been taken.
+   Return value:     None.
+   Functions Called: None.
+   */
+   void Close() {
+      std::lock_guard<std::mutex> lock(mutex);
+
+      closed = true;
+      notEmpty.notify_all();
+   }
+private:
+   std::size_t capacity;              //The most items held at once.
+   bool closed;                       //True once nothing more will be pushed.
+   std::deque<T> items;               //The items pushed and not yet taken, oldest first.
+   std::mutex mutex;                  //Guards items and closed.
+   std::condition_variable notFull;   //Told when an item is taken.
+   std::condition_variable notEmpty;  //Told when an item is pushed or the queue is closed.
+};
@@ -0,0 +1,131 @@
+/*
+File Name:  DistanceCache.cpp
+Author:     Logan Petersen
+Date:       Febuary 2, 2020
+Purpose:    The purpose of this code is to be the function definitions for
+            the prototypes in DistanceCache.h.
+*/
+
+#include "DistanceCache.h"
+#include <utility> //Grants move, which stores a new search without copying it again.
+
+/*
+Purpose:          Construct the cache for a Graph.
+Parameters:       graph, the Graph searched. It must be frozen and must not change while the cache is used.
+                  capacity, the most centers kept at once. 0 is treated as 1.
+Preconditions:    This specific DistanceCache object has not been instantiated.
+Postconditions:   DistanceCache object has been instantiated with no centers kept.
+Return value:     None.
+Functions Called: None.
+*/
+DistanceCache::DistanceCache(const Graph& graph, std::size_t capacity) : graph(graph) {
+   this->capacity = capacity == 0 ? 1 : capacity;
+   questions = 0;
+}
+
+/*
+Purpose:          Give the distances from a center to a few actors/actresses, searching only when the searches kept
+                  for the center have not reached them all. When the most centers are kept, the one asked about
+                  least recently makes way for a new one.
+Parameters:       center, the id of the center.
+                  targets, the ids of the actors/actresses asked about.
+                  scratch, the search scratch of the thread asking.
+                  threads, the number of threads a search uses.
+                  distances, set to one distance for each target, in the order of targets, or -1 if it cannot be reached.
+Preconditions:    A DistanceCache object has been instantiated, and center and every target are vertices of the Graph.
+Postconditions:   The center is kept, with at least the distances given.
+Return value:     True if the distances were answered from a kept search, false if a search was run.
+Functions Called: Graph::DistancesTo(), which runs the search when one is needed.
+*/
+bool DistanceCache::Lookup(std::uint32_t center, const std::vector<std::uint32_t>& targets, Graph::SearchScratch& scratch,
+                           unsigned threads, std::vector<int>& distances) {
+
+   //Local Variables
+   Entry found;
+
+   {
+      std::lock_guard<std::mutex> guard(lock);
+
+      questions++;
+      for (Entry& entry : entries) {
+         //Every kept center has not been checked yet.
+
+         if (entry.center == center) {
+            entry.lastUsed = questions;
+            if (Answer(entry, targets, distances)) {
+               return true;
+            }
+            break;
+         }
+      }
+   }
+
+   //The search runs without the lock, so other questions are answered meanwhile.
+   found.center = center;
+   found.complete = graph.DistancesTo(center, targets, scratch, threads, distances);
+   found.distances = scratch.distances;
+
+   {
+      std::lock_guard<std::mutex> guard(lock);
+      std::size_t replaced = entries.size(); //The entry the new search takes the place of.
+
+      found.lastUsed = ++questions;
+      for (std::size_t i = 0; i < entries.size(); i++) {
+         //Every kept center has not been checked yet.
+
+         if (entries[i].center == center) {
+            replaced = i;
+            break;
+         }
+      }
+
+      //Another thread may have searched the same center meanwhile, and a complete search is never replaced.
+      if (replaced < entries.size() && entries[replaced].complete) {
+         return false;
+      }
+      if (replaced == entries.size() && entries.size() == capacity) {
+         replaced = 0;
+         for (std::size_t i = 1; i < entries.size(); i++) {
+            //Every kept center has not been compared yet.
+
+            if (entries[i].lastUsed < entries[replaced].lastUsed) {
+               replaced = i;
+            }
+         }
+      }
+      if (replaced == entries.size()) {
+         entries.push_back(std::move(found));
+      }
+      else {
+         entries[replaced] = std::move(found);
+      }
+   }
+   return false;
+}
+
+/*
+Purpose:          Give the kept distances of a center's targets, if the kept search reached every one of them.
+Parameters:       entry, what was kept for the center.
+                  targets, the ids of the actors/actresses asked about.
+                  distances, set to one distance for each target when every one is known.
+Preconditions:    The cache is locked.
+Postconditions:   Nothing in the cache changes.
+Return value:     True if every target's distance is known, false otherwise.
+Functions Called: None.
+*/
+bool DistanceCache::Answer(const Entry& entry, const std::vector<std::uint32_t>& targets, std::vector<int>& distances) {
+   for (std::uint32_t target : targets) {
+      //Every target has not been checked yet.
+
+      if (entry.distances[target] == -1 && !entry.complete) {
+         return false;
+      }
+   }
+   distances.resize(targets.size());
+   for (std::size_t i = 0; i < targets.size(); i++) {
+      //Every target's distance has not been copied yet.
+
+      distances[i] = entry.distances[targets[i]];
+   }
+   return true;
+}
@@ -0,0 +1,80 @@
+/*
+File Name:  DistanceCache.h
+Author:     Logan Petersen
+Date:       Febuary 2, 2020
+Purpose:    This is the header file for the DistanceCache class containing DistanceCache's interface.
+            A DistanceCache answers questions about the distances from a center to a few actors/actresses,
+            running a search that stops once every one of them is found, and keeps what each search found
+            for the centers asked about most recently. A later question about the same center is answered
+            from what is kept, without another search, as long as every actor/actress it names was reached
+            before; otherwise a new search goes as far as it needs to and replaces what was kept.
+
+            Every question locks the cache only to look up and to store, so any number of threads may ask
+            at once, each searching with its own scratch.
+*/
+
+#pragma once
+
+#include "Graph.h"
+#include <mutex>   //Grants mutex, which guards the kept searches.
+#include <vector>  //Grants the vectors the searches are kept in.
+
+class DistanceCache {
+public:
+   /*
+   Purpose:          Construct the cache for a Graph.
+   Parameters:       graph, the Graph searched. It must be frozen and must not change while the cache is used.
+                     capacity, the most centers kept at once. 0 is treated as 1.
+   Preconditions:    This specific DistanceCache object has not been instantiated.
+   Postconditions:   DistanceCache object has been instantiated with no centers kept.
+   Return value:     None.
+   Functions Called: None.
+   */
+   DistanceCache(const Graph& graph, std::size_t capacity);
+
+   /*
+   Purpose:          Give the distances from a center to a few actors/actresses, searching only when the searches kept
+                     for the center have not reached them all. When the most centers are kept, the one asked about
+                     least recently makes way for a new one.
+   Parameters:       center, the id of the center.
+                     targets, the ids of the actors/actresses asked about.
+                     scratch, the search scratch of the thread asking.
+                     threads, the number of threads a search uses.
+                     distances, set to one distance for each target, in the order of targets, or -1 if it cannot be reached.
+   Preconditions:    A DistanceCache object has been instantiated, and center and every target are vertices of the Graph.
+   Postconditions:   The center is kept, with at least the distances given.
+   Return value:     True if the distances were answered from a kept search, false if a search was run.
+   Functions Called: Graph::DistancesTo(), which runs the search when one is needed.
+   */
+   bool Lookup(std::uint32_t center, const std::vector<std::uint32_t>& targets, Graph::SearchScratch& scratch, unsigned threads,
+               std::vector<int>& distances);
+
+   DistanceCache(const DistanceCache&) = delete;
+   DistanceCache& operator=(const DistanceCache&) = delete;
+private:
+   //What one search from a center found.
+   struct Entry {
+      std::uint32_t center;        //The id of the center.
+      std::vector<int> distances;  //The distance of every vertex the search reached, or -1.
+      bool complete;               //True when the search reached everything it could, so every -1 cannot be reached.
+      std::uint64_t lastUsed;      //When the center was last asked about, counted in questions.
+   };
+
+   /*
+   Purpose:          Give the kept distances of a center's targets, if the kept search reached every one of them.
+   Parameters:       entry, what was kept for the center.
+                     targets, the ids of the actors/actresses asked about.
+                     distances, set to one distance for each target when every one is known.
+   Preconditions:    The cache is locked.
+   Postconditions:   Nothing in the cache changes.
+   Return value:     True if every target's distance is known, false otherwise.
+   Functions Called: None.
+   */
+   static bool Answer(const Entry& entry, const std::vector<std::uint32_t>& targets, std::vector<int>& distances);
+
+   const Graph& graph;          //The Graph searched.
+   std::size_t capacity;        //The most centers kept at once.
+   std::mutex lock;             //Held while the kept searches are looked up or changed.
+   std::vector<Entry> entries;  //The kept searches, one per center, in no particular order.
+   std::uint64_t questions;     //The questions asked so far, which times when each center was last used.
+};
@@ -8,36 +8,151 @@ Purpose:    The purpose of this code is to be the function definitions for
 */
 
 #include "Graph.h"
+#include "Parallel.h" //Grants ParallelFor, used to build the rows of the frozen graph and search it on every thread.
+#include "SortedOutput.h" //Grants WriteSorted, which prints the distances sorted.
+#include <cctype>     //Grants tolower, for comparing names with case ignored.
+#include <numeric>    //Grants iota, which lists every id before they are sorted by name.
+#include <chrono>     //Grants steady_clock, which times each level of a recorded search.
 
-/*
-Purpose:          Construct the node when Vertex is created without arguments.
-Parameters:       None.
-Preconditions:    This specific Vertex object has not been instantiated.
-Postconditions:   Vertex object has been instantiated with default values.
-Return value:     None.
-Functions Called: None.
-*/
-Graph::Vertex::Vertex() {
-   visited = false;
-   distanceFromBacon = -1; //Distance to bacon is defaulted to "infinity" because distance unknown.
-}
+namespace {
 
-/*
-Purpose:          Construct the node when Vertex is created with arguments.
-Parameters:       inputName, a string that is an actor/actress's name.
-                  inputMovies, a vector of strings, each representing a move that actor/actress was in.
-                  these are used to create the Vertex object that will be used to find the actor/actress's
-                  Bacon number.
-Preconditions:    This specific Vertex object has not been instantiated.
-Postconditions:   Vertex object has been instantiated with default values excluding given values.
-Return value:     None.
-Functions Called: None.
-*/
-Graph::Vertex::Vertex(std::string inputName, std::vector<std::string> inputMovies) {
-   name = inputName;
-   movies = inputMovies;
-   visited = false;
-   distanceFromBacon = -1; //Distance to bacon is defaulted to "infinity" because distance unknown.
+   //MeasureSources runs its sources in batches of BatchWords 64 bit words, one bit per source. The loops over the
+   //words of a batch have a fixed length, so the compiler may turn them into vector instructions where it can.
+   constexpr std::size_t BatchWords = 4;
+   constexpr std::size_t BatchSources = BatchWords * 64;
+
+   //One bit for each source of a batch.
+   struct SourceBits {
+      std::uint64_t word[BatchWords];
+   };
+
+   /*
+   Purpose:          Advance every source of a MeasureSources batch by one step. Each target gathers the bits that
+                     arrived at the entries of its row at the last step, and keeps those of sources that had not
+                     reached it yet. A target stops gathering once every source it was missing has arrived.
+   Parameters:       forEachEntry, called as forEachEntry(i, visit) to hand each entry of target i's row to visit
+                     until visit returns false.
+                     from, the sources that arrived at each entry at the last step.
+                     seen, the sources that have reached each target, which is updated.
+                     arrived, set to the sources that reach each target at this step.
+                     all, a bit for every source of the batch.
+                     begin and end, the targets gathered.
+                     counts, if it is not null, has the entry of every source that reached a target incremented.
+   Preconditions:    No other thread writes the targets from begin up to end.
+   Postconditions:   seen and arrived are updated for the targets from begin up to end.
+   Return value:     None.
+   Functions Called: forEachEntry, once for each target that is missing a source.
+   */
+   template <typename ForEachEntry>
+   void GatherSources(ForEachEntry forEachEntry, const std::vector<SourceBits>& from, std::vector<SourceBits>& seen,
+                      std::vector<SourceBits>& arrived, const SourceBits& all, std::size_t begin, std::size_t end,
+                      std::uint64_t* counts) {
+      for (std::size_t i = begin; i < end; i++) {
+         //Every target of this block has not gathered its row's bits yet.
+
+         SourceBits missing;  //The sources that have not reached this target.
+         SourceBits gathered = {};
+         bool anyMissing = false;
+         for (std::size_t word = 0; word < BatchWords; word++) {
+            //Every word has not been checked yet.
+
+            missing.word[word] = all.word[word] & ~seen[i].word[word];
+            anyMissing = anyMissing || missing.word[word] != 0;
+         }
+         arrived[i] = SourceBits();
+         if (!anyMissing) {
+            continue;
+         }
+
+         forEachEntry(i, [&](std::uint32_t entry) {
+            //Every entry of this row has not been gathered yet.
+
+            const SourceBits& bits = from[entry];
+            bool complete = true;
+            for (std::size_t word = 0; word < BatchWords; word++) {
+               //Every word has not been gathered yet.
+
+               gathered.word[word] |= bits.word[word];
+               complete = complete && (gathered.word[word] & missing.word[word]) == missing.word[word];
+            }
+
+            //Once every missing source has arrived, the other entries cannot add anything.
+            return !complete;
+         });
+
+         for (std::size_t word = 0; word < BatchWords; word++) {
+            //Every word of this target's new sources has not been recorded yet.
+
+            std::uint64_t found = gathered.word[word] & missing.word[word];
+            arrived[i].word[word] = found;
+            seen[i].word[word] |= found;
+            while (counts != nullptr && found != 0) {
+               //Every source that arrived has not been counted yet.
+
+               counts[word * 64 + static_cast<std::size_t>(__builtin_ctzll(found))]++;
+               found &= found - 1;
+            }
+         }
+      }
+   }
+
+   /*
+   Purpose:          Compare two names with case ignored.
+   Parameters:       first and second, the names compared.
+   Preconditions:    None.
+   Postconditions:   Nothing changes.
+   Return value:     Less than 0 if first sorts before second, 0 if they are equal with case ignored, more than 0 otherwise.
+   Functions Called: None.
+   */
+   int CompareFolded(std::string_view first, std::string_view second) {
+      std::size_t length = std::min(first.size(), second.size());
+
+      for (std::size_t i = 0; i < length; i++) {
+         //Every character both names have has not been compared yet.
+
+         int difference = std::tolower(static_cast<unsigned char>(first[i])) - std::tolower(static_cast<unsigned char>(second[i]));
+         if (difference != 0) {
+            return difference;
+         }
+      }
+      return first.size() < second.size() ? -1 : first.size() > second.size() ? 1 : 0;
+   }
+
+   /*
+   Purpose:          Start timing a level of a search, if the search is recording its levels.
+   Parameters:       stats, where the search records its levels, or nullptr.
+   Preconditions:    None.
+   Postconditions:   Nothing changes.
+   Return value:     The time now, or the clock's first time if nothing is recorded, so the clock is only read when needed.
+   Functions Called: None.
+   */
+   std::chrono::steady_clock::time_point StartLevel(const RunStats* stats) {
+      if (RunStatsBuilt && stats != nullptr) {
+         return std::chrono::steady_clock::now();
+      }
+      return std::chrono::steady_clock::time_point();
+   }
+
+   /*
+   Purpose:          Record a level of a search, if the search is recording its levels.
+   Parameters:       stats, where the search records its levels, or nullptr.
+                     distance, the distance of the frontier the level expanded.
+                     frontier, the size of that frontier.
+                     edges, the edges or credits out of it.
+                     direction, how the level was expanded.
+                     start, when the level began, as StartLevel gave it.
+   Preconditions:    None.
+   Postconditions:   The level has been added to stats, if it is not nullptr.
+   Return value:     None.
+   Functions Called: None.
+   */
+   void RecordLevel(RunStats* stats, int distance, std::uint64_t frontier, std::uint64_t edges, const char* direction,
+                    std::chrono::steady_clock::time_point start) {
+      if (RunStatsBuilt && stats != nullptr) {
+         stats->levels.push_back({distance, frontier, edges, direction,
+                                  std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count()});
+      }
+   }
 }
 
 /*
@@ -48,7 +163,20 @@ Postconditions:   Graph object has been instantiated with default values.
 Return value:     None.
 Functions Called: None.
 */
-Graph::Graph() {}
+Graph::Graph() {
+   creditOffsetStorage.assign(1, 0);
+   creditOffsets = creditOffsetStorage;
+   threadCount = DefaultThreadCount();
+   centerName = "Bacon, Kevin (I)";
+   sortedOutput = false;
+   stats = nullptr;
+   order = VertexOrder::File;
+   frozen = false;
+   bipartite = false;
+   compressed = false;
+   rowEntries = 0;
+   frozenPeakBytes = 0;
+}
 
 /*
 Purpose:          Delete the memory allocated by this Graph object.
@@ -59,170 +187,1651 @@ Return value:     None.
 Functions Called: None.
 */
 Graph::~Graph() {
-   for (Vertex* i : vertices) {
-      //Every Vertex inside of Vertices has not been iterated through yet.
-
-      delete i;
-   }
+   //Every table releases its own memory, and the snapshot is unmapped by its MappedFile.
 }
 
 /*
 Purpose:          Add a node Vertex to the graph.
-Parameters:       inputName, a string that represents the name of an actor/actress.
-                  inputMovies, a vector of strings representing the movies the actor/actress was in.
+Parameters:       inputName, a string_view that represents the name of an actor/actress.
+                  inputMovies, a vector of string_views representing the movies the actor/actress was in.
                   Both of these are used to construct a Vertex for the Graph, which allows Graph to
                   eventually calculate the Bacon number for this actor/actress.
 Preconditions:    A Graph object has been instantiated.
-Postconditions:   The Graph object now contains a node Vertex
+Postconditions:   The Graph object now contains a node Vertex, and the Vertex is in the cast of each of its movies.
+                  The cost is proportional to the new Vertex's movies rather than to the size of the Graph.
+                  The Graph is no longer frozen, so its edges will be rebuilt by the next Finalize.
+                  A name already in the Graph, and a movie listed twice, are skipped and counted in its RunStats.
 Return value:     None.
-Functions Called: None.
+Functions Called: Thaw(), which first turns a graph loaded from a snapshot back into vertices.
+                  StringArena::Intern(), which stores the name and each new movie once.
 */
-void Graph::Add(std::string inputName, std::vector<std::string> inputShows) {
+void Graph::Add(std::string_view inputName, const std::vector<std::string_view>& inputShows) {
 
    //Local variables
-   Vertex* newVertex = new Vertex(inputName, inputShows);
+   std::uint32_t newVertex;
+   bool added;
 
-   //When the graph is empty, we only need to add the item.
-   if(vertices.empty()) {
-      vertices.push_back(newVertex);
+   //A graph mapped from a snapshot has no vertices to add to until it is thawed.
+   if (snapshot.Data() != nullptr) {
+      Thaw();
+   }
+
+   //Interning the name also checks if vertex already exists by name.
+   newVertex = names.Intern(inputName, added);
+   if (!added) {
+      if (RunStatsBuilt && stats != nullptr) {
+         stats->duplicateNames++;
+      }
       return;
    }
 
-   //Check if vertex already exists by name.
-   for (Vertex* i : vertices) {
-      //Every Vertex inside of Vertices has not been iterated through yet.
+   //Now that we know that this new vertex belongs in the graph, we can add it.
+   frozen = false;
+   for (std::string_view newVertexMovieName : inputShows) {
+      //Every movie inside newVertex has not been iterated through yet.
 
-      if (i->name == newVertex->name) {
-         return;
+      //Intern the movie, giving it an empty cast the first time it is seen.
+      std::uint32_t movie = titles.Intern(newVertexMovieName, added);
+      if (added) {
+         casts.emplace_back();
+      }
+      std::vector<std::uint32_t>& cast = casts[movie];
+
+      //The same movie listed twice for this actor/actress must not add them to its cast twice.
+      if (!cast.empty() && cast.back() == newVertex) {
+         if (RunStatsBuilt && stats != nullptr) {
+            stats->duplicateTitles++;
+         }
+         continue;
+      }
+      cast.push_back(newVertex);
+      creditIdStorage.push_back(movie);
+   }
+   creditOffsetStorage.push_back(creditIdStorage.size());
+   creditOffsets = creditOffsetStorage;
+   creditIds = creditIdStorage;
+
+   //A renumbered Graph remembers that this Vertex was added after every other.
+   if (!addedOrderStorage.empty()) {
+      addedOrderStorage.push_back(newVertex);
+      addedOrder = addedOrderStorage;
+   }
+}
+
+/*
+Purpose:          Freeze the graph into a compressed sparse row layout for the breadth-first search.
+                  Each thread builds the rows of one block of vertices, and the blocks are then copied into place.
+                  A bipartite Graph instead freezes each movie's cast as its row.
+Parameters:       None.
+Preconditions:    A Graph object has been instantiated.
+Postconditions:   Every Vertex's id indexes offsets, and its neighbors are the ids stored from neighbors[offsets[id]]
+                  up to neighbors[offsets[id + 1]], in increasing order. In a bipartite Graph it is every movie's id
+                  that indexes offsets, and its row is its cast. Nothing is rebuilt if the Graph is already frozen.
+                  The vertices are first numbered in the order chosen with SetOrder. A compressed Graph instead
+                  packs each row into packed, starting at packed[offsets[id]].
+Return value:     None.
+Functions Called: PhaseTimer, which times the freeze when the Graph has RunStats.
+                  Renumber(), which numbers the vertices in the chosen order.
+                  AppendPackedRow(), which packs each row of a compressed Graph.
+*/
+void Graph::Finalize() {
+
+   //Local variables
+   std::vector<std::vector<std::uint32_t>> blockNeighbors(threadCount); //The neighbors found by each block of rows.
+   std::vector<std::vector<std::uint8_t>> blockPacked(threadCount);     //The packed rows of each block, in a compressed Graph.
+   std::vector<std::uint64_t> blockEntries(threadCount, 0);             //The ids in each block's rows.
+   std::vector<std::size_t> blockScratchBytes(threadCount, 0);          //The most scratch space each block needed.
+   const std::size_t vertexCount = VertexCount();
+
+   if (frozen) {
+      return;
+   }
+   PhaseTimer timer(stats, "freeze");
+
+   //Release the old arrays first so they do not count against the new ones.
+   offsets = ArrayView<std::uint64_t>();
+   neighbors = ArrayView<std::uint32_t>();
+   packed = ArrayView<std::uint8_t>();
+   std::vector<std::uint64_t>().swap(offsetStorage);
+   std::vector<std::uint32_t>().swap(neighborStorage);
+   std::vector<std::uint8_t>().swap(packedStorage);
+
+   //The rows are built from the credits and casts, so they are renumbered first. A Graph in the order the vertices
+   //were added is left alone.
+   if (order != VertexOrder::File || !addedOrder.empty()) {
+      Renumber();
+   }
+
+   //A bipartite Graph freezes each movie's cast, which is already in increasing order, so the rows are only copied.
+   if (bipartite && !compressed) {
+      offsetStorage.assign(titles.Size() + 1, 0);
+      for (std::size_t movie = 0; movie < casts.size(); movie++) {
+         //Every movie has not had its row placed yet.
+
+         offsetStorage[movie + 1] = offsetStorage[movie] + casts[movie].size();
       }
+      neighborStorage.resize(offsetStorage.back());
+      ParallelFor(casts.size(), threadCount, [this](std::size_t begin, std::size_t end, std::size_t) {
+         for (std::size_t movie = begin; movie < end; movie++) {
+            //Every movie of this block has not had its cast copied yet.
+
+            std::copy(casts[movie].begin(), casts[movie].end(), neighborStorage.begin() + offsetStorage[movie]);
+         }
+      });
+      rowEntries = neighborStorage.size();
+      frozenPeakBytes = offsetStorage.capacity() * sizeof(std::uint64_t) + neighborStorage.capacity() * sizeof(std::uint32_t);
    }
+   else {
+      const std::size_t rowCount = bipartite ? titles.Size() : vertexCount;
+      offsetStorage.assign(rowCount + 1, 0);
+
+      //Each block of rows finds its own rows, leaving each row's length in offsetStorage.
+      ParallelFor(rowCount, threadCount, [&](std::size_t begin, std::size_t end, std::size_t block) {
+         std::vector<std::uint32_t> coStars; //Every vertex sharing a movie with the current vertex, possibly repeated.
+         std::vector<std::uint32_t>& rows = blockNeighbors[block];
 
-   //Now that we know that this new vertex belongs in the graph, we can add it and point it, now added, to new things.
-   vertices.push_back(newVertex);
-   newVertex = vertices.back();
+         for (std::size_t i = begin; i < end; i++) {
+            //Every row inside of this block has not been iterated through yet.
 
-   for (Vertex* i : vertices) {
-      //Every Vertex inside of Vertices has not been iterated through yet.
+            std::size_t rowStart = rows.size();
+            if (bipartite) {
+               rows.insert(rows.end(), casts[i].begin(), casts[i].end());
+            }
+            else {
+               coStars.clear();
+               for (std::uint32_t movie : CreditsOf(static_cast<std::uint32_t>(i))) {
+                  //Every movie of this vertex has not been iterated through yet.
+
+                  coStars.insert(coStars.end(), casts[movie].begin(), casts[movie].end());
+               }
 
-      for (std::string newVertexMovieName : newVertex->movies) {
-         //Every movie inside newVertex has not been iterated through yet.
+               //Sorting keeps the edges in the order the vertices were added, and makes duplicate co-stars adjacent.
+               std::sort(coStars.begin(), coStars.end());
+               coStars.erase(std::unique(coStars.begin(), coStars.end()), coStars.end());
 
-         //If the node being compared is not the node just added, so we do not have nodes pointing to themselves, and the current
-         //Vertex being iterated through contains the movie inside newVertex currently being compared.
-         if (i->name != newVertex->name && std::find(i->movies.begin(), i->movies.end(), newVertexMovieName) != i->movies.end()) {
+               for (std::uint32_t coStar : coStars) {
+                  //Every co-star of this vertex has not been iterated through yet.
 
-            //Make sure we do not already have an edge between these nodes.
-            if (std::find(newVertex->edges.begin(), newVertex->edges.end(), i) == newVertex->edges.end()) {
-               newVertex->edges.push_back(i);
+                  //Vertices do not point to themselves.
+                  if (coStar != i) {
+                     rows.push_back(coStar);
+                  }
+               }
+            }
+            blockEntries[block] += rows.size() - rowStart;
 
-               //This makes it an undirected graph.
-               i->edges.push_back(newVertex);
+            //A compressed Graph packs each row as soon as it is found, so only one row at a time is kept as 32 bit ids.
+            if (compressed) {
+               AppendPackedRow(rows.data() + rowStart, rows.size() - rowStart, blockPacked[block]);
+               rows.resize(rowStart);
             }
+            offsetStorage[i + 1] = compressed ? blockPacked[block].size() : rows.size();
+            blockScratchBytes[block] = std::max(blockScratchBytes[block], coStars.capacity() * sizeof(std::uint32_t));
+         }
+
+         //Turn the running totals back into row lengths, so the prefix sum below can place the block.
+         for (std::size_t i = end; i > begin + 1; i--) {
+            //Every row after the first in this block has not been iterated through yet.
+
+            offsetStorage[i] -= offsetStorage[i - 1];
+         }
+      });
+
+      //The prefix sum of the row lengths gives every row's start.
+      for (std::size_t i = 1; i < offsetStorage.size(); i++) {
+         //Every row has not been iterated through yet.
+
+         offsetStorage[i] += offsetStorage[i - 1];
+      }
+      //The packed rows are followed by the padding their readers may look into.
+      if (compressed) {
+         packedStorage.assign(offsetStorage.back() + PackedPadding, 0);
+      }
+      else {
+         neighborStorage.resize(offsetStorage.back());
+      }
+      rowEntries = 0;
+      frozenPeakBytes = offsetStorage.capacity() * sizeof(std::uint64_t) + neighborStorage.capacity() * sizeof(std::uint32_t) +
+                        packedStorage.capacity();
+      for (std::size_t block = 0; block < blockNeighbors.size(); block++) {
+         //Every block has not been iterated through yet.
+
+         rowEntries += blockEntries[block];
+         frozenPeakBytes += blockNeighbors[block].capacity() * sizeof(std::uint32_t) + blockPacked[block].capacity() +
+                            blockScratchBytes[block];
+      }
+
+      //The blocks split the rows the same way as before, so each block copies its rows to where they belong.
+      ParallelFor(rowCount, threadCount, [this, &blockNeighbors, &blockPacked](std::size_t begin, std::size_t, std::size_t block) {
+         if (compressed) {
+            std::copy(blockPacked[block].begin(), blockPacked[block].end(), packedStorage.begin() + offsetStorage[begin]);
+         }
+         else {
+            std::copy(blockNeighbors[block].begin(), blockNeighbors[block].end(), neighborStorage.begin() + offsetStorage[begin]);
+         }
+         std::vector<std::uint32_t>().swap(blockNeighbors[block]);
+         std::vector<std::uint8_t>().swap(blockPacked[block]);
+      });
+   }
+   offsets = offsetStorage;
+   neighbors = neighborStorage;
+   packed = packedStorage;
+
+   //Sort the names for FindMatching, each block sorting its own part before the parts are merged together.
+   {
+      std::vector<std::size_t> blockStarts(threadCount + 1, vertexCount); //Where each block's part starts.
+      auto before = [this](std::uint32_t first, std::uint32_t second) {
+         int comparison = CompareFolded(NameOf(first), NameOf(second));
+         return comparison < 0 || (comparison == 0 && AddedPosition(first) < AddedPosition(second));
+      };
+
+      nameOrder = ArrayView<std::uint32_t>();
+      nameOrderStorage.resize(vertexCount);
+      std::iota(nameOrderStorage.begin(), nameOrderStorage.end(), 0);
+      ParallelFor(vertexCount, threadCount, [this, &blockStarts, &before](std::size_t begin, std::size_t end, std::size_t block) {
+         blockStarts[block] = begin;
+         std::sort(nameOrderStorage.begin() + begin, nameOrderStorage.begin() + end, before);
+      });
+      for (std::size_t width = 1; width < threadCount; width *= 2) {
+         //Some parts have not been merged with their neighbors yet.
+
+         for (std::size_t block = 0; block + width < threadCount; block += 2 * width) {
+            //Every pair of parts of this width has not been merged yet.
+
+            std::inplace_merge(nameOrderStorage.begin() + blockStarts[block], nameOrderStorage.begin() + blockStarts[block + width],
+                               nameOrderStorage.begin() + blockStarts[std::min(block + 2 * width, static_cast<std::size_t>(threadCount))], before);
          }
       }
+      nameOrder = nameOrderStorage;
    }
+   frozen = true;
 }
 
 /*
-Purpose:          Output the Bacon numbers for each actor/actress according to specifications.
-Parameters:       out, the ostream that is the stream of characters being sent to the terminal.
-                  graph, the Graph that is going to be printed according to specifications.
-Preconditions:    The Graph has been instantiated.
-Postconditions:   If the Graph is empty, print a statement that Graph is empty.
-                  Otherwise, display each actor/actress and their Bacon Number according to specifications.
-Return value:     out, an ostream to allow statements to be chained according to operator<<'s specification.
-Functions Called: GenerateNumbers(), a function that generates the string of actors/actresses and their Bacon
-                  number based on specifications to be sent to terminal.
-                  FindKevinBacon(), a function that returns the location of the Kevin Bacon Vertex.
-                  This function prints GenerateNumbers, which requires FindKevinBacon to print the degree's of
-                  seperation from Kevin Bacon.
+Purpose:          Choose whether the Graph is frozen as co-star edges or as the movies between actors/actresses.
+                  Co-star edges grow with the square of each cast, so a movie with a cast of 500 costs about 125
+                  thousand edges, while a bipartite Graph keeps each credit once and its searches step from
+                  actors/actresses to their movies and from movies to their casts.
+Parameters:       enabled, true for the bipartite layout, false for co-star edges.
+Preconditions:    A Graph object has been instantiated.
+Postconditions:   The next Finalize freezes the chosen layout. Distances are the same in either layout.
+Return value:     None.
+Functions Called: Thaw(), if the Graph was mapped from a snapshot of the other layout.
 */
-std::ostream& operator<<(std::ostream& out, Graph& graph) {
+void Graph::SetBipartite(bool enabled) {
+   if (enabled == bipartite) {
+      return;
+   }
+   bipartite = enabled;
 
-   if (!graph.vertices.empty()) {
-      out << graph.GenerateNumbers(graph.FindKevinBacon());
+   //The mapped rows are of the other layout, and only a Graph that owns its tables can be frozen again.
+   if (snapshot.Data() != nullptr) {
+      Thaw();
    }
-   else {
-      out << "No actor/actresses in this Graph.\n";
+   frozen = false;
+}
+
+/*
+Purpose:          Choose whether the rows are frozen as 32 bit ids or packed, as PackedRows.h describes. Packed
+                  rows keep the gaps between neighboring ids in 1 to 4 bytes each and are unpacked as the searches
+                  read them, so they take much less memory, most of all once the vertices are numbered with
+                  SetOrder so that co-stars sit close together. The rows of a bipartite Graph are casts of a few
+                  actors/actresses each, so packing them saves little.
+Parameters:       enabled, true to pack the rows, false for 32 bit ids.
+Preconditions:    A Graph object has been instantiated.
+Postconditions:   The next Finalize freezes the rows in the chosen form. Every search gives the same answers either way.
+Return value:     None.
+Functions Called: Thaw(), if the Graph was mapped from a snapshot of the other form.
+*/
+void Graph::SetCompressed(bool enabled) {
+   if (enabled == compressed) {
+      return;
    }
-   return out;
+   compressed = enabled;
+
+   //The mapped rows are in the other form, and only a Graph that owns its tables can be frozen again.
+   if (snapshot.Data() != nullptr) {
+      Thaw();
+   }
+   frozen = false;
 }
 
 /*
-Purpose:          Generate a string that contains every actor/actress and their bacon number on seperate lines.
-Parameters:       start, a pointer to a Vertex. This is used to start the breadth first search.
-Preconditions:    The Graph object has been instantiated.
-Postconditions:   Nothing in the Graph changes, and a string is returned to operator<< for printing.
-Return value:     A string that contains every actor/actress and their Bacon number properly formatted according to specifications.
+Purpose:          Choose how many threads the Graph uses to freeze itself.
+Parameters:       count, the number of threads. 0 is treated as 1.
+Preconditions:    A Graph object has been instantiated.
+Postconditions:   Later work on the Graph uses up to count threads.
+Return value:     None.
 Functions Called: None.
 */
-std::string Graph::GenerateNumbers(Vertex* start) {
+void Graph::SetThreadCount(unsigned count) {
+   threadCount = count == 0 ? 1 : count;
+}
 
-   //Local Variables
-   std::queue<Vertex*> bfsQueue;
-   std::string output;
-   Vertex* poppedVertex;
+/*
+Purpose:          Choose how the vertices are numbered when the Graph is frozen.
+Parameters:       newOrder, the order. Every order but File renumbers the vertices, so ids change, but the Graph
+                  remembers the order they were added in, and everything printed by name keeps that order.
+Preconditions:    A Graph object has been instantiated.
+Postconditions:   The next Finalize numbers the vertices in newOrder.
+Return value:     None.
+Functions Called: Thaw(), if the Graph was mapped from a snapshot of another order.
+*/
+void Graph::SetOrder(VertexOrder newOrder) {
+   if (newOrder == order) {
+      return;
+   }
+   order = newOrder;
+
+   //Only a Graph that owns its tables can be renumbered.
+   if (snapshot.Data() != nullptr) {
+      Thaw();
+   }
+   frozen = false;
+}
 
-   //If Kevin Bacon is not in the graph.
-   if(start == nullptr) {
-      return "Kevin Bacon not in Graph.\n";
+/*
+Purpose:          Read the name of a VertexOrder, as given to --order.
+Parameters:       name, one of file, bfs, degree or rcm.
+                  found, set to the order named.
+Preconditions:    None.
+Postconditions:   Nothing changes if name is not an order.
+Return value:     True if name is an order, false otherwise.
+Functions Called: None.
+*/
+bool Graph::OrderFromName(std::string_view name, VertexOrder& found) {
+   if (name == "file") {
+      found = VertexOrder::File;
+   }
+   else if (name == "bfs") {
+      found = VertexOrder::Breadth;
+   }
+   else if (name == "degree") {
+      found = VertexOrder::Degree;
+   }
+   else if (name == "rcm") {
+      found = VertexOrder::ReverseCuthillMcKee;
+   }
+   else {
+      return false;
    }
+   return true;
+}
+
+/*
+Purpose:          Give where an actor/actress was in the order the vertices were added, whatever their id now.
+Parameters:       id, the id of the actor/actress's Vertex.
+Preconditions:    id is less than VertexCount().
+Postconditions:   Nothing in the Graph changes.
+Return value:     The number of vertices added before them.
+Functions Called: None.
+*/
+std::uint32_t Graph::AddedPosition(std::uint32_t id) const {
+   return addedOrder.empty() ? id : addedOrder[id];
+}
 
-   start->distanceFromBacon = 0;
-   bfsQueue.push(start);
-   start->visited = true;
+/*
+Purpose:          Choose where the Graph records the phases it runs, what it skips while adding, and the levels of
+                  the searches operator<< runs.
+Parameters:       stats, the RunStats to record in, or nullptr to record nothing. It must outlive the Graph's use of it.
+Preconditions:    A Graph object has been instantiated.
+Postconditions:   Later work on the Graph is recorded in stats. Nothing is recorded if RunStats are not built.
+Return value:     None.
+Functions Called: None.
+*/
+void Graph::SetStats(RunStats* stats) {
+   this->stats = RunStatsBuilt ? stats : nullptr;
+}
 
-   while(!bfsQueue.empty()) {
-      //The queue contains Vertex pointers.
+/*
+Purpose:          Give where the Graph records what it does.
+Parameters:       None.
+Preconditions:    A Graph object has been instantiated.
+Postconditions:   Nothing in the Graph changes.
+Return value:     The RunStats given to SetStats, or nullptr if there is none.
+Functions Called: None.
+*/
+RunStats* Graph::Stats() const {
+   return stats;
+}
 
-      //Remove inital vertex, and add to output.
-      poppedVertex = bfsQueue.front();
-      bfsQueue.pop();
-      output += (poppedVertex->name + '\t' + std::to_string(poppedVertex->distanceFromBacon) + '\n');
+/*
+Purpose:          Report the memory used by the frozen graph.
+Parameters:       None.
+Preconditions:    A Graph object has been instantiated.
+Postconditions:   Nothing in the Graph changes.
+Return value:     The largest number of bytes the offsets, rows and scratch arrays occupied while freezing the Graph.
+Functions Called: None.
+*/
+std::size_t Graph::FrozenPeakBytes() const {
+   return frozenPeakBytes;
+}
 
-      for(Vertex* i : poppedVertex->edges) {
-         //Every edge of the poppedVertex has not been iterated through yet.
+/*
+Purpose:          Report the memory the frozen rows take, which is what SetCompressed saves.
+Parameters:       None.
+Preconditions:    A Graph object has been instantiated.
+Postconditions:   Nothing in the Graph changes.
+Return value:     The bytes of the offsets and the rows, whether they are 32 bit ids or packed, or 0 if the Graph
+                  has not been frozen.
+Functions Called: None.
+*/
+std::size_t Graph::RowBytes() const {
+   if (!frozen) {
+      return 0;
+   }
+   return offsets.size() * sizeof(std::uint64_t) + neighbors.size() * sizeof(std::uint32_t) + packed.size();
+}
 
-         if(i->visited == false) {
-            i->distanceFromBacon = poppedVertex->distanceFromBacon + 1;
-            bfsQueue.push(i);
-            i->visited = true;
-         }
-      }
+/*
+Purpose:          Report the number of undirected edges in the frozen graph.
+Parameters:       None.
+Preconditions:    A Graph object has been instantiated.
+Postconditions:   Nothing in the Graph changes.
+Return value:     The number of undirected edges, or 0 if the Graph has not been frozen. The edges of a bipartite
+                  Graph are its credits, each joining an actor/actress to a movie.
+Functions Called: None.
+*/
+std::size_t Graph::EdgeCount() const {
+   if (!frozen) {
+      return 0;
    }
+   return bipartite ? rowEntries : rowEntries / 2;
+}
+
+/*
+Purpose:          Report the number of actors/actresses in the graph.
+Parameters:       None.
+Preconditions:    A Graph object has been instantiated.
+Postconditions:   Nothing in the Graph changes.
+Return value:     The number of vertices, which is one more than the largest id.
+Functions Called: None.
+*/
+std::size_t Graph::VertexCount() const {
+   return names.Size();
+}
+
+/*
+Purpose:          Give the name of an actor/actress.
+Parameters:       id, the id of the actor/actress's Vertex.
+Preconditions:    id is less than VertexCount().
+Postconditions:   Nothing in the Graph changes.
+Return value:     The name, which stays valid until the Graph next changes.
+Functions Called: StringArena::Get(), which gives the name.
+*/
+std::string_view Graph::NameOf(std::uint32_t id) const {
+   return names.Get(id);
+}
+
+/*
+Purpose:          Give the name of a movie.
+Parameters:       movie, the movie's id.
+Preconditions:    movie is the id of a movie in the Graph.
+Postconditions:   Nothing in the Graph changes.
+Return value:     The name as it was cleaned by the parser, which stays valid until the Graph next changes.
+Functions Called: StringArena::Get(), which gives the name.
+*/
+std::string_view Graph::TitleOf(std::uint32_t movie) const {
+   return titles.Get(movie);
+}
+
+/*
+Purpose:          Give the movies of an actor/actress.
+Parameters:       id, the id of the actor/actress's Vertex.
+Preconditions:    id is less than VertexCount().
+Postconditions:   Nothing in the Graph changes.
+Return value:     The movie ids, in the order they were listed, which stay valid until the Graph next changes.
+Functions Called: None.
+*/
+ArrayView<std::uint32_t> Graph::CreditsOf(std::uint32_t id) const {
+   return ArrayView<std::uint32_t>(creditIds.begin() + creditOffsets[id], static_cast<std::size_t>(creditOffsets[id + 1] - creditOffsets[id]));
+}
+
+/*
+Purpose:          Turn a graph loaded from a snapshot back into vertices that can be added to.
+Parameters:       None.
+Preconditions:    A snapshot is mapped.
+Postconditions:   The Graph owns copies of the snapshot's names, movies and credits, casts is rebuilt from the
+                  credits, nothing is mapped, and the Graph is no longer frozen.
+Return value:     None.
+Functions Called: StringArena::Own(), which copies the names and movies out of the mapping.
+*/
+void Graph::Thaw() {
+   names.Own();
+   titles.Own();
+   creditOffsetStorage.assign(creditOffsets.begin(), creditOffsets.end());
+   creditIdStorage.assign(creditIds.begin(), creditIds.end());
+   creditOffsets = creditOffsetStorage;
+   creditIds = creditIdStorage;
+   addedOrderStorage.assign(addedOrder.begin(), addedOrder.end());
+   addedOrder = addedOrderStorage;
 
-   //For the nodes that are not connected to any other nodes.
-   for(Vertex* i : vertices) {
-      //Every Vertex inside of Vertices has not been iterated through yet.
+   casts.assign(titles.Size(), std::vector<std::uint32_t>());
+   for (std::uint32_t id = 0; id < VertexCount(); id++) {
+      //Every Vertex of the snapshot has not been put into its casts yet.
 
-      if(i->distanceFromBacon == -1) {
-         output += (i->name + '\t' + "infinity" + '\n');
+      for (std::uint32_t movie : CreditsOf(id)) {
+         //Every movie of this Vertex has not been iterated through yet.
+
+         casts[movie].push_back(id);
       }
    }
-   return output;
+
+   //Everything is now owned by the Graph, so the mapping can go.
+   offsets = ArrayView<std::uint64_t>();
+   neighbors = ArrayView<std::uint32_t>();
+   packed = ArrayView<std::uint8_t>();
+   nameOrder = ArrayView<std::uint32_t>();
+   snapshot.Close();
+   frozen = false;
 }
 
 /*
-Purpose:          Find the Kevin Bacon Vertex in the Graph.
+Purpose:          Number the vertices in the chosen order. The order is found by walking the credits and casts, so
+                  it can be chosen before the rows are built, and every table indexed by a Vertex's id is moved
+                  to its new id. A vertex's co-stars are counted through its movies, so one shared twice counts twice.
 Parameters:       None.
-Preconditions:    The Graph object has been instantiated.
-Postconditions:   Nothing in the Graph changes, and a pointer to either null or the Bacon Vertex is returned.
-Return value:     A pointer to either null or the Bacon Vertex is returned. Nullptr is returned if Kevin Bacon does not exist, otherwise
-                  the pointer points to the Kevin Bacon Vertex.
-Functions Called: None.
+Preconditions:    The Graph owns its tables, rather than reading them from a mapping.
+Postconditions:   The names, credits and casts are in the new numbering, each cast still in increasing order, and
+                  AddedPosition gives every Vertex's place in the order they were added. The frozen rows are not
+                  touched, since Finalize builds them next.
+Return value:     None.
+Functions Called: StringArena::Clear() and StringArena::Intern(), which store the names again in their new order.
+                  ParallelFor(), which renumbers and sorts the casts.
 */
-Graph::Vertex* Graph::FindKevinBacon() {
+void Graph::Renumber() {
 
    //Local Variables
-   Vertex* kevinBaconPtr;
+   const std::size_t vertexCount = VertexCount();
+   std::vector<std::uint32_t> oldIds;               //The old id of every new id, in the order of the new ids.
+   std::vector<std::uint32_t> newIds(vertexCount);  //The new id of every old id.
+   std::vector<std::uint64_t> degree(vertexCount);  //The co-stars of every vertex, counted through its movies.
+   std::vector<std::uint32_t> positions(vertexCount); //AddedPosition of every new id.
+   std::string nameBytes;                           //Every name, copied out in the new order.
+   std::vector<std::size_t> nameEnds;               //Where each name ends in nameBytes.
+   std::vector<std::uint64_t> newCreditOffsets;
+   std::vector<std::uint32_t> newCreditIds;
+
+   oldIds.reserve(vertexCount);
+   if (order == VertexOrder::File) {
+
+      //Putting every vertex back where it was added undoes the last renumbering.
+      oldIds.resize(vertexCount);
+      for (std::uint32_t id = 0; id < vertexCount; id++) {
+         //Every vertex has not been put back yet.
+
+         oldIds[AddedPosition(id)] = id;
+      }
+   }
+   else {
+      for (std::uint32_t id = 0; id < vertexCount; id++) {
+         //Every vertex has not been counted yet.
+
+         for (std::uint32_t movie : CreditsOf(id)) {
+            //Every movie of this vertex has not been counted yet.
+
+            degree[id] += casts[movie].size() - 1;
+         }
+      }
+
+      //Each order starts from every vertex, ranked by co-stars. Ties keep the order the vertices were added.
+      std::vector<std::uint32_t> starts(vertexCount);
+      std::iota(starts.begin(), starts.end(), 0);
+      std::sort(starts.begin(), starts.end(), [this, &degree](std::uint32_t first, std::uint32_t second) {
+         if (degree[first] != degree[second]) {
+            return order == VertexOrder::ReverseCuthillMcKee ? degree[first] < degree[second] : degree[first] > degree[second];
+         }
+         return AddedPosition(first) < AddedPosition(second);
+      });
+
+      if (order == VertexOrder::Degree) {
+         oldIds = starts;
+      }
+      else {
+         std::vector<bool> reached(vertexCount, false);   //True for each vertex once it has a new id.
+         std::vector<bool> expanded(casts.size(), false); //True for each movie once its cast has been reached.
+         std::vector<std::uint32_t> found;                //The vertices the current vertex reached first.
+
+         for (std::uint32_t start : starts) {
+            //Every vertex has not been tried as the start of a search yet.
+
+            if (reached[start]) {
+               continue;
+            }
+            reached[start] = true;
+            oldIds.push_back(start);
+
+            //The new ids are the search's queue, so the search ends when it catches up with them.
+            for (std::size_t next = oldIds.size() - 1; next < oldIds.size(); next++) {
+               //The search has vertices it has not expanded yet.
+
+               found.clear();
+               for (std::uint32_t movie : CreditsOf(oldIds[next])) {
+                  //Every movie of this vertex has not been expanded yet.
+
+                  if (expanded[movie]) {
+                     continue;
+                  }
+                  expanded[movie] = true;
+                  for (std::uint32_t coStar : casts[movie]) {
+                     //Every member of this movie's cast has not been checked yet.
+
+                     if (!reached[coStar]) {
+                        reached[coStar] = true;
+                        found.push_back(coStar);
+                     }
+                  }
+               }
+               if (order == VertexOrder::ReverseCuthillMcKee) {
+                  std::stable_sort(found.begin(), found.end(), [&degree](std::uint32_t first, std::uint32_t second) {
+                     return degree[first] < degree[second];
+                  });
+               }
+               oldIds.insert(oldIds.end(), found.begin(), found.end());
+            }
+         }
+         if (order == VertexOrder::ReverseCuthillMcKee) {
+            std::reverse(oldIds.begin(), oldIds.end());
+         }
+      }
+   }
+   for (std::uint32_t id = 0; id < vertexCount; id++) {
+      //Every new id has not been given to its vertex yet.
+
+      newIds[oldIds[id]] = id;
+      positions[id] = AddedPosition(oldIds[id]);
+   }
+
+   //The names are copied out before the arena is cleared, then stored again so each name's id is its new id.
+   nameEnds.reserve(vertexCount);
+   for (std::uint32_t id : oldIds) {
+      //Every name has not been copied out yet.
+
+      nameBytes += NameOf(id);
+      nameEnds.push_back(nameBytes.size());
+   }
+   names.Clear();
+   for (std::size_t id = 0; id < vertexCount; id++) {
+      //Every name has not been stored again yet.
+
+      bool added;
+      std::size_t nameBegin = id == 0 ? 0 : nameEnds[id - 1];
+      names.Intern(std::string_view(nameBytes).substr(nameBegin, nameEnds[id] - nameBegin), added);
+   }
+   std::string().swap(nameBytes);
+
+   //Each Vertex's row of credits moves to its new id.
+   newCreditOffsets.reserve(vertexCount + 1);
+   newCreditOffsets.push_back(0);
+   newCreditIds.reserve(creditIds.size());
+   for (std::uint32_t id : oldIds) {
+      //Every row of credits has not been moved yet.
+
+      ArrayView<std::uint32_t> row = CreditsOf(id);
+      newCreditIds.insert(newCreditIds.end(), row.begin(), row.end());
+      newCreditOffsets.push_back(newCreditIds.size());
+   }
+   creditOffsetStorage.swap(newCreditOffsets);
+   creditIdStorage.swap(newCreditIds);
+   creditOffsets = creditOffsetStorage;
+   creditIds = creditIdStorage;
+
+   ParallelFor(casts.size(), threadCount, [this, &newIds](std::size_t begin, std::size_t end, std::size_t) {
+      for (std::size_t movie = begin; movie < end; movie++) {
+         //Every cast of this block has not been renumbered yet.
 
-   for(Vertex* i : vertices) {
-      //Every Vertex inside of Vertices has not been iterated through yet.
+         for (std::uint32_t& member : casts[movie]) {
+            //Every member of this cast has not been renumbered yet.
 
-      if(i->name == "Bacon, Kevin (I)") {
-         kevinBaconPtr = i;
-         return kevinBaconPtr;
+            member = newIds[member];
+         }
+         std::sort(casts[movie].begin(), casts[movie].end());
       }
+   });
+
+   //In the order they were added, every id is its own position, so nothing needs to be kept.
+   if (order == VertexOrder::File) {
+      std::vector<std::uint32_t>().swap(addedOrderStorage);
    }
-   return nullptr;
+   else {
+      addedOrderStorage.swap(positions);
+   }
+   addedOrder = addedOrderStorage;
+}
+
+/*
+Purpose:          Output the Bacon numbers for each actor/actress according to specifications.
+Parameters:       out, the ostream that is the stream of characters being sent to the terminal.
+                  graph, the Graph that is going to be printed according to specifications.
+Preconditions:    The Graph has been instantiated.
+Postconditions:   If the Graph is empty, print a statement that Graph is empty.
+                  Otherwise, display each actor/actress and their Bacon Number according to specifications.
+Return value:     out, an ostream to allow statements to be chained according to operator<<'s specification.
+Functions Called: GenerateNumbers(), a function that prints the actors/actresses and their Bacon number based
+                  on specifications through an OutputWriter on out, a level at a time, or GenerateSortedNumbers()
+                  if SetSortedOutput chose sorted output.
+                  Find(), a function that returns the location of the Kevin Bacon Vertex, or of the center chosen
+                  with SetCenter. This function prints GenerateNumbers, which requires Find to print the degree's
+                  of seperation from Kevin Bacon.
+*/
+std::ostream& operator<<(std::ostream& out, Graph& graph) {
+
+   //Local Variables
+   Graph::SearchScratch scratch;
+   std::uint32_t center;
+
+   if (graph.VertexCount() != 0) {
+      graph.Finalize();
+      center = graph.Find(graph.centerName);
+      scratch.stats = graph.stats;
+
+      //If Kevin Bacon, or whoever was chosen instead, is not in the graph.
+      if (center == Graph::NoVertex && graph.centerName == "Bacon, Kevin (I)") {
+         out << "Kevin Bacon not in Graph.\n";
+      }
+      else if (center == Graph::NoVertex) {
+         out << graph.centerName << " not in Graph.\n";
+      }
+      else if (graph.sortedOutput) {
+         OutputWriter writer(out);
+         graph.GenerateSortedNumbers(center, scratch, graph.threadCount, writer);
+      }
+      else {
+         OutputWriter writer(out);
+         graph.GenerateNumbers(center, scratch, graph.threadCount, writer);
+      }
+   }
+   else {
+      out << "No actor/actresses in this Graph.\n";
+   }
+   return out;
+}
+
+/*
+Purpose:          Print every actor/actress and their distance from a center on seperate lines. Each distance is
+                  printed and flushed as soon as the breadth first search finds it, so the first lines appear at
+                  once and the output never needs more memory than the writer's buffer.
+Parameters:       start, the id of the center Vertex. This is used to start the breadth first search.
+                  scratch, the space the search works in.
+                  threads, the number of threads the search uses.
+                  out, the writer the lines are printed through.
+Preconditions:    The Graph object has been instantiated and frozen, and start is a Vertex of it.
+Postconditions:   Nothing in the Graph changes, and every line has been given to out.
+Return value:     None. The lines are formatted according to specifications, and actors/actresses with the same
+                  distance are listed in the order they were added.
+Functions Called: ComputeDistances(), which runs the breadth first search and hands over each level.
+*/
+void Graph::GenerateNumbers(std::uint32_t start, SearchScratch& scratch, unsigned threads, OutputWriter& out) const {
+
+   //Local Variables
+   const std::vector<int>& distanceFromBacon = scratch.distances; //Distance to the center of every vertex, or -1 for "infinity".
+   std::vector<std::uint32_t> level;  //The vertices of the level being printed, in the order they were added.
+
+   ComputeDistances(start, scratch, threads, [this, &out, &level](int distance, const std::vector<std::uint32_t>& found) {
+      level.assign(found.begin(), found.end());
+      std::sort(level.begin(), level.end(), [this](std::uint32_t first, std::uint32_t second) {
+         return AddedPosition(first) < AddedPosition(second);
+      });
+      for(std::uint32_t i : level) {
+         //Every vertex at this distance has not been printed yet.
+
+         out.Write(NameOf(i));
+         out.Write('\t');
+         out.WriteNumber(distance);
+         out.Write('\n');
+      }
+      out.Flush();
+      return true;
+   });
+
+   //For the nodes that are not connected to any other nodes, in the order they were added.
+   level.clear();
+   for(std::uint32_t i = 0; i < distanceFromBacon.size(); i++) {
+      //Every Vertex has not been iterated through yet.
+
+      if(distanceFromBacon[i] == -1) {
+         level.push_back(i);
+      }
+   }
+   if (!addedOrder.empty()) {
+      std::sort(level.begin(), level.end(), [this](std::uint32_t first, std::uint32_t second) {
+         return addedOrder[first] < addedOrder[second];
+      });
+   }
+   for (std::uint32_t i : level) {
+      //Every unreached Vertex has not been printed yet.
+
+      out.Write(NameOf(i));
+      out.Write("\tinfinity\n");
+   }
+}
+
+/*
+Purpose:          Print every actor/actress and their distance from a center on seperate lines, sorted by distance
+                  and then by name in the order first name last name, with those who cannot be reached last.
+Parameters:       start, the id of the center Vertex. This is used to start the breadth first search.
+                  scratch, the space the search works in.
+                  threads, the number of threads the search and the sort use.
+                  out, the writer the lines are printed through.
+Preconditions:    The Graph object has been instantiated and frozen, and start is a Vertex of it.
+Postconditions:   Nothing in the Graph changes, and every line has been given to out.
+Return value:     None.
+Functions Called: ComputeDistances(), which runs the breadth first search, and WriteSorted(), which sorts and prints
+                  the lines.
+*/
+void Graph::GenerateSortedNumbers(std::uint32_t start, SearchScratch& scratch, unsigned threads, OutputWriter& out) const {
+
+   //Local Variables
+   std::vector<std::uint32_t> ids(VertexCount());
+
+   ComputeDistances(start, scratch, threads, nullptr);
+   std::iota(ids.begin(), ids.end(), 0);
+   WriteSorted(ids, scratch.distances, [this](std::uint32_t id) { return NameOf(id); }, threads, out);
+}
+
+/*
+Purpose:          Find the distance from one vertex to every other with a parallel, level by level breadth first search.
+                  Each level is expanded either top-down, where every frontier vertex claims its unvisited neighbors,
+                  or bottom-up, where every unvisited vertex looks for any neighbor in the frontier and stops at the
+                  first it finds. Bottom-up wins when the frontier holds a large share of the remaining edges, which
+                  happens at the middle levels of the co-star graph. A bipartite Graph is searched by
+                  SearchByMovie instead.
+Parameters:       start, the id of the vertex the search starts from.
+                  scratch, the space the search works in. Its distances are left holding the distance of every vertex
+                  from start, or -1 if it cannot be reached.
+                  threads, the number of threads the search uses.
+                  levelFound, if it is not empty, called with each level, starting with the level of start alone,
+                  as soon as the level is found. Its vertices are in no particular order. It returns false to end
+                  the search there, leaving every vertex farther away at -1, and true to go on.
+Preconditions:    The Graph object has been instantiated and frozen.
+Postconditions:   Nothing in the Graph changes, so any number of searches with their own scratch may run at once.
+Return value:     None.
+Functions Called: ParallelFor(), which splits each level across the threads, and levelFound.
+                  SearchByMovie(), which searches a bipartite Graph.
+*/
+void Graph::ComputeDistances(std::uint32_t start, SearchScratch& scratch, unsigned threads, const LevelFound& levelFound) const {
+
+   //Local Variables
+   const std::size_t vertexCount = VertexCount();
+   std::vector<int>& distances = scratch.distances;
+   std::atomic<std::uint64_t>* visited;
+   std::vector<std::uint64_t>& inFrontier = scratch.inFrontier;
+   std::vector<std::uint32_t>& frontier = scratch.frontier;
+   std::vector<std::vector<std::uint32_t>>& blockNext = scratch.blockNext;
+   std::uint64_t unexploredEdges = offsets.back();                         //Edges out of vertices that have no distance yet.
+   bool bottomUp = false;
+   int level = 0;
+
+   //These are the switching thresholds from Beamer, Asanovic and Patterson's direction-optimizing search.
+   const std::uint64_t topDownShare = 14;  //Go bottom-up once the frontier's edges are more than 1/14 of those unexplored.
+   const std::uint64_t bottomUpShare = 24; //Go back top-down once the frontier is smaller than 1/24 of the vertices.
+
+   //The edges are only compared with each other, so a compressed Graph counts them as the bytes of their packed rows,
+   //which offsets gives without reading the rows themselves.
+
+   //Reuse the scratch's space, only allocating when this Graph needs more than it has.
+   if (scratch.visitedWords != (vertexCount + 63) / 64) {
+      scratch.visitedWords = (vertexCount + 63) / 64;
+      scratch.visited.reset(new std::atomic<std::uint64_t>[scratch.visitedWords]);
+   }
+   visited = scratch.visited.get();
+   for (std::size_t i = 0; i < scratch.visitedWords; i++) {
+      //Every word of visited has not been cleared yet.
+
+      visited[i].store(0, std::memory_order_relaxed);
+   }
+   if (threads == 0) {
+      threads = 1;
+   }
+   blockNext.resize(threads);
+   for (std::vector<std::uint32_t>& next : blockNext) {
+      //Every block's list has not been cleared yet.
+
+      next.clear();
+   }
+   frontier.clear();
+   distances.assign(vertexCount, -1);
+   distances[start] = 0;
+   visited[start / 64].fetch_or(std::uint64_t(1) << (start % 64));
+   frontier.push_back(start);
+
+   //A bipartite Graph's rows are casts, so its search steps through movies instead of co-star edges.
+   if (bipartite) {
+      SearchByMovie(scratch, threads, levelFound);
+      return;
+   }
+   unexploredEdges -= offsets[start + 1] - offsets[start];
+   if (levelFound && !levelFound(0, frontier)) {
+      return;
+   }
+
+   while (!frontier.empty()) {
+      //The last level found at least one vertex.
+
+      std::uint64_t frontierEdges = 0;
+      for (std::uint32_t i : frontier) {
+         //Every frontier vertex has not been counted yet.
+
+         frontierEdges += offsets[i + 1] - offsets[i];
+      }
+
+      //Choose the direction of this level.
+      if (!bottomUp && frontierEdges > unexploredEdges / topDownShare) {
+         bottomUp = true;
+      }
+      else if (bottomUp && frontier.size() < vertexCount / bottomUpShare) {
+         bottomUp = false;
+      }
+
+      //A recorded level of a compressed Graph counts its frontier's edges again, in ids.
+      if (compressed && RunStatsBuilt && scratch.stats != nullptr) {
+         frontierEdges = 0;
+         for (std::uint32_t i : frontier) {
+            //Every frontier vertex has not been counted yet.
+
+            frontierEdges += RowLength(i);
+         }
+      }
+
+      std::chrono::steady_clock::time_point levelStart = StartLevel(scratch.stats);
+      if (bottomUp) {
+         inFrontier.assign((vertexCount + 63) / 64, 0);
+         for (std::uint32_t i : frontier) {
+            //Every frontier vertex has not been marked yet.
+
+            inFrontier[i / 64] |= std::uint64_t(1) << (i % 64);
+         }
+
+         //Every unvisited vertex checks its neighbors for one in the frontier. Only its own block writes its distance.
+         ParallelFor(vertexCount, threads, [&](std::size_t begin, std::size_t end, std::size_t block) {
+            for (std::size_t i = begin; i < end; i++) {
+               //Every vertex of this block has not been checked yet.
+
+               if (visited[i / 64].load(std::memory_order_relaxed) & (std::uint64_t(1) << (i % 64))) {
+                  continue;
+               }
+               ForEachInRow(i, [&](std::uint32_t neighbor) {
+                  //Every edge of this vertex has not been checked yet.
+
+                  if (inFrontier[neighbor / 64] & (std::uint64_t(1) << (neighbor % 64))) {
+                     distances[i] = level + 1;
+                     blockNext[block].push_back(static_cast<std::uint32_t>(i));
+                     return false;
+                  }
+                  return true;
+               });
+            }
+         });
+
+         //Marking the new vertices visited waits until every block is done, so no block sees this level's vertices.
+         for (std::vector<std::uint32_t>& next : blockNext) {
+            //Every block's new vertices have not been marked yet.
+
+            for (std::uint32_t i : next) {
+               //Every new vertex of this block has not been marked yet.
+
+               visited[i / 64].fetch_or(std::uint64_t(1) << (i % 64), std::memory_order_relaxed);
+            }
+         }
+      }
+      else {
+
+         //Every frontier vertex claims its unvisited neighbors. Setting the visited bit decides which claim wins.
+         ParallelFor(frontier.size(), threads, [&](std::size_t begin, std::size_t end, std::size_t block) {
+            for (std::size_t i = begin; i < end; i++) {
+               //Every frontier vertex of this block has not been expanded yet.
+
+               ForEachInRow(frontier[i], [&](std::uint32_t neighbor) {
+                  //Every edge of this frontier vertex has not been checked yet.
+
+                  std::uint64_t bit = std::uint64_t(1) << (neighbor % 64);
+                  if (!(visited[neighbor / 64].load(std::memory_order_relaxed) & bit) &&
+                      !(visited[neighbor / 64].fetch_or(bit, std::memory_order_relaxed) & bit)) {
+                     distances[neighbor] = level + 1;
+                     blockNext[block].push_back(neighbor);
+                  }
+                  return true;
+               });
+            }
+         });
+      }
+      RecordLevel(scratch.stats, level, frontier.size(), frontierEdges, bottomUp ? "bottom-up" : "top-down", levelStart);
+
+      //The new vertices become the next frontier.
+      frontier.clear();
+      for (std::vector<std::uint32_t>& next : blockNext) {
+         //Every block's new vertices have not been moved to the frontier yet.
+
+         frontier.insert(frontier.end(), next.begin(), next.end());
+         next.clear();
+      }
+      for (std::uint32_t i : frontier) {
+         //Every new vertex has not had its edges removed from the unexplored ones yet.
+
+         unexploredEdges -= offsets[i + 1] - offsets[i];
+      }
+      level++;
+      if (levelFound && !frontier.empty() && !levelFound(level, frontier)) {
+         return;
+      }
+   }
+}
+
+/*
+Purpose:          Find the distances from a center to a few actors/actresses, searching only as far as the farthest of
+                  them. The search stops at the level where the last of them is found, rather than going on to reach
+                  everything, so asking about near neighbors costs a small part of a whole search.
+Parameters:       start, the id of the center.
+                  targets, the ids of the actors/actresses asked about.
+                  scratch, the space the search works in. Its distances are left holding every distance the search
+                  found, and -1 for every vertex it did not reach.
+                  threads, the number of threads the search uses.
+                  distances, set to one distance for each target, in the order of targets, or -1 if it cannot be reached.
+Preconditions:    The Graph object has been instantiated and frozen, and start and every target are vertices of it.
+Postconditions:   Nothing in the Graph changes.
+Return value:     True if the search reached everything it could, so every -1 left in scratch's distances cannot be
+                  reached. False if it stopped early, so a -1 there may only be farther than the search went.
+Functions Called: ComputeDistances(), which runs the search and stops it once every target has a distance.
+*/
+bool Graph::DistancesTo(std::uint32_t start, const std::vector<std::uint32_t>& targets, SearchScratch& scratch, unsigned threads,
+                        std::vector<int>& distances) const {
+
+   //Local Variables
+   bool complete = true; //Cleared if the search is stopped before it runs out of vertices.
+
+   //A level usually finds far more vertices than there are targets, so the targets are checked rather than the level.
+   ComputeDistances(start, scratch, threads, [&scratch, &targets, &complete](int, const std::vector<std::uint32_t>&) {
+      for (std::uint32_t target : targets) {
+         //Every target has not been checked yet.
+
+         if (scratch.distances[target] == -1) {
+            return true;
+         }
+      }
+      complete = false;
+      return false;
+   });
+
+   distances.resize(targets.size());
+   for (std::size_t i = 0; i < targets.size(); i++) {
+      //Every target's distance has not been copied yet.
+
+      distances[i] = scratch.distances[targets[i]];
+   }
+   return complete;
+}
+
+/*
+Purpose:          Find the distance from one vertex to every other in a bipartite Graph, a level at a time. Each
+                  level has the frontier's actors/actresses claim their movies, and each movie claimed expands its
+                  cast, so every movie is expanded at most once and a search costs time proportional to the credits.
+Parameters:       scratch, the space the search works in, with the start alone in its frontier. Its distances are
+                  left as ComputeDistances leaves them.
+                  threads, the number of threads the search uses.
+                  levelFound, if it is not empty, called with each level as ComputeDistances calls it, and ending
+                  the search when it returns false.
+Preconditions:    The Graph object has been instantiated and frozen as a bipartite Graph, and scratch has been
+                  prepared by ComputeDistances.
+Postconditions:   Nothing in the Graph changes.
+Return value:     None.
+Functions Called: ParallelFor(), which splits each level across the threads, and levelFound.
+*/
+void Graph::SearchByMovie(SearchScratch& scratch, unsigned threads, const LevelFound& levelFound) const {
+
+   //Local Variables
+   const std::size_t movieCount = titles.Size();
+   std::vector<int>& distances = scratch.distances;
+   std::atomic<std::uint64_t>* visited = scratch.visited.get();
+   std::atomic<std::uint64_t>* expanded;
+   std::vector<std::uint32_t>& frontier = scratch.frontier;
+   std::vector<std::vector<std::uint32_t>>& blockNext = scratch.blockNext;
+   int level = 0;
+
+   if (scratch.expandedWords != (movieCount + 63) / 64) {
+      scratch.expandedWords = (movieCount + 63) / 64;
+      scratch.expanded.reset(new std::atomic<std::uint64_t>[scratch.expandedWords]);
+   }
+   expanded = scratch.expanded.get();
+   for (std::size_t i = 0; i < scratch.expandedWords; i++) {
+      //Every word of expanded has not been cleared yet.
+
+      expanded[i].store(0, std::memory_order_relaxed);
+   }
+   if (levelFound && !levelFound(0, frontier)) {
+      return;
+   }
+
+   while (!frontier.empty()) {
+      //The last level found at least one vertex.
+
+      std::chrono::steady_clock::time_point levelStart = StartLevel(scratch.stats);
+      std::uint64_t frontierCredits = 0;
+
+      //Only a recorded level needs its credits counted.
+      if (RunStatsBuilt && scratch.stats != nullptr) {
+         for (std::uint32_t i : frontier) {
+            //Every frontier vertex has not been counted yet.
+
+            frontierCredits += CreditsOf(i).size();
+         }
+      }
+
+      //Every frontier vertex claims its movies, and expands the cast of each movie it wins.
+      ParallelFor(frontier.size(), threads, [&](std::size_t begin, std::size_t end, std::size_t block) {
+         for (std::size_t i = begin; i < end; i++) {
+            //Every frontier vertex of this block has not been expanded yet.
+
+            for (std::uint32_t movie : CreditsOf(frontier[i])) {
+               //Every movie of this frontier vertex has not been claimed yet.
+
+               std::uint64_t movieBit = std::uint64_t(1) << (movie % 64);
+               if ((expanded[movie / 64].load(std::memory_order_relaxed) & movieBit) ||
+                   (expanded[movie / 64].fetch_or(movieBit, std::memory_order_relaxed) & movieBit)) {
+                  continue;
+               }
+               ForEachInRow(movie, [&](std::uint32_t neighbor) {
+                  //Every member of this movie's cast has not been checked yet.
+
+                  std::uint64_t bit = std::uint64_t(1) << (neighbor % 64);
+                  if (!(visited[neighbor / 64].load(std::memory_order_relaxed) & bit) &&
+                      !(visited[neighbor / 64].fetch_or(bit, std::memory_order_relaxed) & bit)) {
+                     distances[neighbor] = level + 1;
+                     blockNext[block].push_back(neighbor);
+                  }
+                  return true;
+               });
+            }
+         }
+      });
+      RecordLevel(scratch.stats, level, frontier.size(), frontierCredits, "by movie", levelStart);
+
+      //The new vertices become the next frontier.
+      frontier.clear();
+      for (std::vector<std::uint32_t>& next : blockNext) {
+         //Every block's new vertices have not been moved to the frontier yet.
+
+         frontier.insert(frontier.end(), next.begin(), next.end());
+         next.clear();
+      }
+      level++;
+      if (levelFound && !frontier.empty() && !levelFound(level, frontier)) {
+         return;
+      }
+   }
+}
+
+/*
+Purpose:          Find the shortest chain of actor, shared movie, actor between two actors/actresses with a
+                  bidirectional breadth first search. A search grows from each end, always growing whichever has
+                  the smaller frontier by one whole level, until the two meet. Only the vertices near the two
+                  ends are reached, rather than everything a search from one end would reach. In a bipartite
+                  Graph each search steps through movies, expanding each movie at most once.
+Parameters:       from, the id of the first actor/actress.
+                  to, the id of the second actor/actress.
+                  scratch, the space the search works in.
+                  path, filled with the chain, its length and the number of vertices reached.
+Preconditions:    The Graph object has been instantiated and frozen, and from and to are vertices of it.
+Postconditions:   Nothing in the Graph changes, so any number of searches with their own scratch may run at once.
+Return value:     None.
+Functions Called: CreditsOf(), to pick a movie shared by each pair of actors/actresses along the chain.
+*/
+void Graph::FindPath(std::uint32_t from, std::uint32_t to, SearchScratch& scratch, Path& path) const {
+
+   //Local Variables
+   const std::size_t vertexCount = VertexCount();
+   const std::size_t movieCount = bipartite ? titles.Size() : 0;
+   std::vector<std::uint32_t> next;      //The level being found.
+   std::uint32_t meeting = NoVertex;     //The vertex the shortest chain found so far passes through.
+   int best = -1;                        //The length of that chain.
+
+   path = Path();
+
+   //The marks only need clearing when the scratch is new to this Graph, or when stamp wraps around.
+   if (scratch.forwardMark.size() != vertexCount || scratch.forwardMovieMark.size() != movieCount || scratch.stamp == 0xFFFFFFFF) {
+      scratch.forwardMark.assign(vertexCount, 0);
+      scratch.backwardMark.assign(vertexCount, 0);
+      scratch.forwardMovieMark.assign(movieCount, 0);
+      scratch.backwardMovieMark.assign(movieCount, 0);
+      scratch.forwardParent.resize(vertexCount);
+      scratch.backwardParent.resize(vertexCount);
+      scratch.forwardDistance.resize(vertexCount);
+      scratch.backwardDistance.resize(vertexCount);
+      scratch.stamp = 0;
+   }
+   scratch.stamp++;
+   const std::uint32_t stamp = scratch.stamp;
+
+   scratch.forwardMark[from] = stamp;
+   scratch.forwardParent[from] = NoVertex;
+   scratch.forwardDistance[from] = 0;
+   scratch.forwardFrontier.assign(1, from);
+   scratch.backwardMark[to] = stamp;
+   scratch.backwardParent[to] = NoVertex;
+   scratch.backwardDistance[to] = 0;
+   scratch.backwardFrontier.assign(1, to);
+   path.visitedVertices = from == to ? 1 : 2;
+   if (from == to) {
+      meeting = from;
+      best = 0;
+   }
+
+   while (best == -1 && !scratch.forwardFrontier.empty() && !scratch.backwardFrontier.empty()) {
+      //Neither search has run out of vertices and they have not met.
+
+      //Grow the side with the smaller frontier, which keeps the number of vertices reached down.
+      bool forward = scratch.forwardFrontier.size() <= scratch.backwardFrontier.size();
+      std::vector<std::uint32_t>& frontier = forward ? scratch.forwardFrontier : scratch.backwardFrontier;
+      std::vector<std::uint32_t>& mark = forward ? scratch.forwardMark : scratch.backwardMark;
+      std::vector<std::uint32_t>& parent = forward ? scratch.forwardParent : scratch.backwardParent;
+      std::vector<int>& distance = forward ? scratch.forwardDistance : scratch.backwardDistance;
+      const std::vector<std::uint32_t>& otherMark = forward ? scratch.backwardMark : scratch.forwardMark;
+      const std::vector<int>& otherDistance = forward ? scratch.backwardDistance : scratch.forwardDistance;
+      std::vector<std::uint32_t>& movieMark = forward ? scratch.forwardMovieMark : scratch.backwardMovieMark;
+
+      //Give a neighbor of a vertex of this level its place in the next level, unless it already has one.
+      auto reach = [&](std::uint32_t i, std::uint32_t neighbor) {
+         if (mark[neighbor] == stamp) {
+            return;
+         }
+         mark[neighbor] = stamp;
+         parent[neighbor] = i;
+         distance[neighbor] = distance[i] + 1;
+         next.push_back(neighbor);
+         if (otherMark[neighbor] != stamp) {
+            path.visitedVertices++;
+         }
+
+         //The whole level is finished before stopping, since a later vertex of it may give a shorter chain.
+         else if (best == -1 || distance[neighbor] + otherDistance[neighbor] < best) {
+            best = distance[neighbor] + otherDistance[neighbor];
+            meeting = neighbor;
+         }
+      };
+
+      next.clear();
+      for (std::uint32_t i : frontier) {
+         //Every vertex of this level has not been expanded yet.
+
+         if (bipartite) {
+            for (std::uint32_t movie : CreditsOf(i)) {
+               //Every movie of this vertex has not been expanded yet.
+
+               //A movie this search has already expanded has nobody left in its cast to give a place.
+               if (movieMark[movie] == stamp) {
+                  continue;
+               }
+               movieMark[movie] = stamp;
+               ForEachInRow(movie, [&](std::uint32_t neighbor) {
+                  //Every member of this movie's cast has not been checked yet.
+
+                  reach(i, neighbor);
+                  return true;
+               });
+            }
+         }
+         else {
+            ForEachInRow(i, [&](std::uint32_t neighbor) {
+               //Every edge of this vertex has not been checked yet.
+
+               reach(i, neighbor);
+               return true;
+            });
+         }
+      }
+      frontier.swap(next);
+   }
+
+   if (best == -1) {
+      return;
+   }
+
+   //Walk from the meeting vertex back to each end.
+   path.distance = best;
+   for (std::uint32_t i = meeting; i != NoVertex; i = scratch.forwardParent[i]) {
+      //The start has not been reached yet.
+
+      path.actors.push_back(i);
+   }
+   std::reverse(path.actors.begin(), path.actors.end());
+   for (std::uint32_t i = scratch.backwardParent[meeting]; i != NoVertex && meeting != to; i = scratch.backwardParent[i]) {
+      //The end has not been reached yet.
+
+      path.actors.push_back(i);
+   }
+
+   //Name a movie each neighboring pair shared, taking the first one listed for the earlier actor/actress.
+   for (std::size_t i = 0; i + 1 < path.actors.size(); i++) {
+      //Every link of the chain has not been given a movie yet.
+
+      ArrayView<std::uint32_t> first = CreditsOf(path.actors[i]);
+      ArrayView<std::uint32_t> second = CreditsOf(path.actors[i + 1]);
+      for (std::uint32_t movie : first) {
+         //Every movie of the earlier actor/actress has not been checked yet.
+
+         if (std::find(second.begin(), second.end(), movie) != second.end()) {
+            path.movies.push_back(movie);
+            break;
+         }
+      }
+   }
+}
+
+/*
+Purpose:          Measure the distances from many sources at once with a bit-parallel, multi-source breadth first
+                  search. Each vertex keeps one bit per source of a batch, in words that are ORed together, so one
+                  pass over the edges advances every source of the batch by a level. Each level has every vertex
+                  gather the bits of its neighbors, so the blocks of vertices can be split across the threads
+                  without sharing anything they write. In a bipartite Graph each level first has every movie
+                  gather the bits of its cast, then every vertex gather the bits of its movies.
+Parameters:       sources, the ids of the sources.
+                  stats, cleared and then filled with one entry per source, in the order of sources.
+                  threads, the number of threads the search uses.
+Preconditions:    The Graph object has been instantiated and frozen, and every source is a vertex of it.
+Postconditions:   Nothing in the Graph changes.
+Return value:     None.
+Functions Called: ParallelFor(), which splits each level across the threads.
+*/
+void Graph::MeasureSources(const std::vector<std::uint32_t>& sources, std::vector<SourceStats>& stats, unsigned threads) const {
+
+   //Local Variables
+   const std::size_t vertexCount = VertexCount();
+   std::vector<SourceBits> seen(vertexCount);       //The sources that have reached each vertex.
+   std::vector<SourceBits> visit(vertexCount);      //The sources that reached each vertex at the last level.
+   std::vector<SourceBits> next(vertexCount);       //The sources that reach each vertex at this level.
+   const std::size_t movieCount = bipartite ? titles.Size() : 0;
+   std::vector<SourceBits> movieSeen(movieCount);   //The sources that have reached each movie, in a bipartite Graph.
+   std::vector<SourceBits> movieNext(movieCount);   //The sources that reach each movie at this level.
+   std::vector<std::vector<std::uint64_t>> blockFound(threads == 0 ? 1 : threads); //How many vertices each block found
+                                                                                    //for each source of the batch.
+
+   //The frozen rows may be packed, while the credits are always 32 bit ids.
+   auto frozenRow = [this](std::size_t i, auto visit) {
+      ForEachInRow(i, visit);
+   };
+   auto creditRow = [this](std::size_t i, auto visit) {
+      for (std::uint32_t movie : CreditsOf(static_cast<std::uint32_t>(i))) {
+         //Every movie of this vertex has not been visited yet.
+
+         if (!visit(movie)) {
+            return;
+         }
+      }
+   };
+
+   stats.assign(sources.size(), SourceStats());
+   for (std::size_t first = 0; first < sources.size(); first += BatchSources) {
+      //Every batch of sources has not been measured yet.
+
+      std::size_t batchSize = std::min(BatchSources, sources.size() - first);
+      SourceBits all = {};   //A bit for every source of this batch.
+      bool found = true;
+      int level = 0;
+
+      std::fill(seen.begin(), seen.end(), SourceBits());
+      std::fill(visit.begin(), visit.end(), SourceBits());
+      std::fill(movieSeen.begin(), movieSeen.end(), SourceBits());
+      for (std::size_t i = 0; i < batchSize; i++) {
+         //Every source of this batch has not been placed yet.
+
+         std::uint32_t source = sources[first + i];
+         seen[source].word[i / 64] |= std::uint64_t(1) << (i % 64);
+         visit[source].word[i / 64] |= std::uint64_t(1) << (i % 64);
+         all.word[i / 64] |= std::uint64_t(1) << (i % 64);
+         stats[first + i].source = source;
+      }
+
+      while (found) {
+         //The last level reached at least one vertex from some source.
+
+         level++;
+         for (std::vector<std::uint64_t>& counts : blockFound) {
+            //Every block's counts have not been cleared yet.
+
+            counts.assign(batchSize, 0);
+         }
+
+         //A bipartite Graph takes two steps a level, from the last level's vertices to their movies and on to their casts.
+         if (bipartite) {
+            ParallelFor(movieCount, threads, [&](std::size_t begin, std::size_t end, std::size_t) {
+               GatherSources(frozenRow, visit, movieSeen, movieNext, all, begin, end, nullptr);
+            });
+            ParallelFor(vertexCount, threads, [&](std::size_t begin, std::size_t end, std::size_t block) {
+               GatherSources(creditRow, movieNext, seen, next, all, begin, end, blockFound[block].data());
+            });
+         }
+         else {
+            ParallelFor(vertexCount, threads, [&](std::size_t begin, std::size_t end, std::size_t block) {
+               GatherSources(frozenRow, visit, seen, next, all, begin, end, blockFound[block].data());
+            });
+         }
+
+         //Add up what the blocks found at this level.
+         found = false;
+         for (const std::vector<std::uint64_t>& counts : blockFound) {
+            //Every block has not been added up yet.
+
+            for (std::size_t i = 0; i < counts.size(); i++) {
+               //Every source of the batch has not been added up yet.
+
+               if (counts[i] != 0) {
+                  stats[first + i].reached += counts[i];
+                  stats[first + i].distanceSum += counts[i] * static_cast<std::uint64_t>(level);
+                  stats[first + i].eccentricity = level;
+                  found = true;
+               }
+            }
+         }
+         visit.swap(next);
+      }
+   }
+}
+
+/*
+Purpose:          Rank the actors/actresses with the most co-stars as centers of the Graph. Each is printed on its
+                  own line as name, average distance, eccentricity and the number of others reached, separated by
+                  tabs. Those reaching more come first, and those reaching the same number are ranked by average
+                  distance, so the first line is the best center of the largest connected part of the Graph.
+Parameters:       count, the number of actors/actresses to rank.
+                  threads, the number of threads the search uses.
+                  out, the writer the ranking is printed through.
+Preconditions:    The Graph object has been instantiated and frozen.
+Postconditions:   Nothing in the Graph changes, and every line has been given to out.
+Return value:     None.
+Functions Called: MeasureSources(), which measures every source.
+*/
+void Graph::RankCenters(std::size_t count, unsigned threads, OutputWriter& out) const {
+
+   //Local Variables
+   std::vector<std::uint32_t> sources(VertexCount());
+   std::vector<std::uint64_t> degree(VertexCount()); //The number of co-stars of every vertex.
+   std::vector<SourceStats> stats;
+
+   //A bipartite Graph counts a co-star once for every movie they share, which ranks the vertices nearly the same.
+   ParallelFor(degree.size(), threads, [this, &degree](std::size_t begin, std::size_t end, std::size_t) {
+      for (std::size_t i = begin; i < end; i++) {
+         //Every vertex of this block has not been counted yet.
+
+         if (!bipartite) {
+            degree[i] = RowLength(i);
+            continue;
+         }
+         for (std::uint32_t movie : CreditsOf(static_cast<std::uint32_t>(i))) {
+            //Every movie of this vertex has not been counted yet.
+
+            degree[i] += RowLength(movie) - 1;
+         }
+      }
+   });
+
+   //The sources are the vertices with the most co-stars, which is where the centers are found.
+   count = std::min(count, sources.size());
+   std::iota(sources.begin(), sources.end(), 0);
+   std::partial_sort(sources.begin(), sources.begin() + count, sources.end(), [this, &degree](std::uint32_t first, std::uint32_t second) {
+      return degree[first] > degree[second] || (degree[first] == degree[second] && AddedPosition(first) < AddedPosition(second));
+   });
+   sources.resize(count);
+
+   MeasureSources(sources, stats, threads);
+
+   //Among sources reaching the same number, the smaller sum is the smaller average, and comparing sums keeps it exact.
+   std::sort(stats.begin(), stats.end(), [this](const SourceStats& first, const SourceStats& second) {
+      if (first.reached != second.reached) {
+         return first.reached > second.reached;
+      }
+      if (first.distanceSum != second.distanceSum) {
+         return first.distanceSum < second.distanceSum;
+      }
+      return AddedPosition(first.source) < AddedPosition(second.source);
+   });
+
+   for (const SourceStats& i : stats) {
+      //Every source has not been printed yet.
+
+      out.Write(NameOf(i.source));
+      out.Write('\t');
+      if (i.reached == 0) {
+         out.Write("infinity");
+      }
+      else {
+         out.WriteDecimal(static_cast<double>(i.distanceSum) / static_cast<double>(i.reached), 4);
+      }
+      out.Write('\t');
+      out.WriteNumber(i.eccentricity);
+      out.Write('\t');
+      out.WriteNumber(static_cast<long long>(i.reached));
+      out.Write('\n');
+   }
+}
+
+/*
+Purpose:          Choose the actor/actress whose distances operator<< prints.
+Parameters:       name, the actor/actress's name as it is written in the actors list.
+Preconditions:    A Graph object has been instantiated.
+Postconditions:   operator<< measures from name instead of from Kevin Bacon.
+Return value:     None.
+Functions Called: None.
+*/
+void Graph::SetCenter(std::string_view name) {
+   centerName = name;
+}
+
+/*
+Purpose:          Choose whether operator<< prints the distances as the search finds them or sorted, as SortedOutput.h
+                  describes. Sorted output gives each name in the order first name last name and depends on nothing
+                  but the names and distances, but cannot print anything until the search is done.
+Parameters:       enabled, true to sort, false to print each level as it is found.
+Preconditions:    A Graph object has been instantiated.
+Postconditions:   operator<< and LiveGraph::Write print in the chosen way.
+Return value:     None.
+Functions Called: None.
+*/
+void Graph::SetSortedOutput(bool enabled) {
+   sortedOutput = enabled;
+}
+
+/*
+Purpose:          Give whether operator<< prints the distances sorted.
+Parameters:       None.
+Preconditions:    A Graph object has been instantiated.
+Postconditions:   Nothing in the Graph changes.
+Return value:     True if SetSortedOutput chose sorted output, false otherwise.
+Functions Called: None.
+*/
+bool Graph::SortedOutput() const {
+   return sortedOutput;
+}
+
+/*
+Purpose:          Find an actor/actress's Vertex by name, through the name hash table, so the cost does not grow
+                  with the size of the Graph.
+Parameters:       name, the actor/actress's name as it is written in the actors list.
+Preconditions:    The Graph object has been instantiated.
+Postconditions:   Nothing in the Graph changes.
+Return value:     The id of the Vertex, or NoVertex if no actor/actress has that name.
+Functions Called: StringArena::Find(), which looks the name up.
+*/
+std::uint32_t Graph::Find(std::string_view name) const {
+   return names.Find(name);
+}
+
+/*
+Purpose:          Find a movie's id by name, through the movie hash table.
+Parameters:       title, the movie's name as it was cleaned by the parser.
+Preconditions:    The Graph object has been instantiated.
+Postconditions:   Nothing in the Graph changes.
+Return value:     The id of the movie, or NoVertex if no movie has that name.
+Functions Called: StringArena::Find(), which looks the name up.
+*/
+std::uint32_t Graph::FindMovie(std::string_view title) const {
+   return titles.Find(title);
+}
+
+/*
+Purpose:          Report the number of distinct movies in the graph.
+Parameters:       None.
+Preconditions:    A Graph object has been instantiated.
+Postconditions:   Nothing in the Graph changes.
+Return value:     The number of movies, which is one more than the largest movie id.
+Functions Called: None.
+*/
+std::size_t Graph::MovieCount() const {
+   return titles.Size();
+}
+
+/*
+Purpose:          Give the name of the actor/actress operator<< measures distances from.
+Parameters:       None.
+Preconditions:    A Graph object has been instantiated.
+Postconditions:   Nothing in the Graph changes.
+Return value:     The name, which is Kevin Bacon's unless SetCenter chose another.
+Functions Called: None.
+*/
+const std::string& Graph::CenterName() const {
+   return centerName;
+}
+
+/*
+Purpose:          Find every actor/actress whose name matches text with case ignored, either exactly or as a
+                  prefix, so "bacon, kevin" finds "Bacon, Kevin (I)". The names are binary searched in their
+                  sorted order, so the cost grows with the log of the number of vertices and the number of matches.
+Parameters:       text, what the names are matched against.
+                  prefix, true if names need only start with text, false if they must equal it.
+                  matches, cleared and then filled with the ids that match, in the order of their names.
+Preconditions:    The Graph object has been instantiated and frozen.
+Postconditions:   Nothing in the Graph changes.
+Return value:     None.
+Functions Called: NameOf(), which gives the names compared.
+*/
+void Graph::FindMatching(std::string_view text, bool prefix, std::vector<std::uint32_t>& matches) const {
+
+   //Local Variables
+   const std::uint32_t* match = std::lower_bound(nameOrder.begin(), nameOrder.end(), text, [this](std::uint32_t id, std::string_view key) {
+      return CompareFolded(NameOf(id), key) < 0;
+   });
+
+   matches.clear();
+   for (; match != nameOrder.end(); match++) {
+      //The names from the first that could match have not run out.
+
+      std::string_view name = NameOf(*match);
+      if (prefix) {
+         name = name.substr(0, text.size());
+      }
+      if (CompareFolded(name, text) != 0) {
+         break;
+      }
+      matches.push_back(*match);
+   }
+}
+
+/*
+Purpose:          Give the number of threads the Graph was told to use.
+Parameters:       None.
+Preconditions:    A Graph object has been instantiated.
+Postconditions:   Nothing in the Graph changes.
+Return value:     The thread count, which is at least 1.
+Functions Called: None.
+*/
+unsigned Graph::ThreadCount() const {
+   return threadCount;
 }
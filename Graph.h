@@ -12,12 +12,81 @@ Purpose:    This is the header file for the Graph class containing Graph's inter
 #include <iostream>  //Grants the use of the ostream for operator <<.
 #include <vector>    //Grants the vector that will be used for storing movie names.
 #include <string>    //Grants string for storage of information such as names of people and movies.
-#include <list>      //Grants the list for use of storing edges in Vertex and the Vertices of Graph.
-#include <queue>     //Gives a queue, which is used to implement the breadth-first search.
-#include <algorithm> //Gives find, which is used when adding new nodes.
+#include <string_view> //Grants string_view, which is how names and movies are handed to the Graph by the parser.
+#include <algorithm> //Gives sort and unique, which are used to collect co-stars when freezing the graph.
+#include <cstdint>   //Grants fixed width integers for the compressed sparse row arrays.
+#include <cstddef>   //Grants size_t for reporting memory usage.
+#include <atomic>    //Grants atomic, for the visited bits shared by the threads of a breadth first search.
+#include <memory>    //Grants unique_ptr, which owns a search's visited bits.
+#include <functional> //Grants function, which is told about each level of a breadth first search as it is found.
+#include "ArrayView.h"  //Grants ArrayView, through which the frozen graph is read wherever its arrays live.
+#include "MappedFile.h" //Grants the mapping a snapshot is loaded through.
+#include "StringArena.h" //Grants StringArena, which stores every name and movie once.
+#include "OutputWriter.h" //Grants OutputWriter, which the distances are printed through.
+#include "RunStats.h"     //Grants RunStats, which --stats records the phases and searches in.
+#include "PackedRows.h"   //Grants the packed rows a compressed Graph is frozen in.
 
 class Graph {
 public:
+   static constexpr std::uint32_t NoVertex = 0xFFFFFFFF; //The id given when there is no such Vertex.
+
+   //Everything one breadth first search writes to. Each search needs its own, so that searches from different
+   //centers can run on the same Graph at once, and keeping one between searches saves allocating it again.
+   struct SearchScratch {
+      std::vector<int> distances;                           //The distance of every vertex from the center, or -1.
+      std::unique_ptr<std::atomic<std::uint64_t>[]> visited; //One bit per vertex, set once it has a distance.
+      std::size_t visitedWords = 0;                         //The number of words in visited.
+      std::vector<std::uint64_t> inFrontier;                //One bit per vertex of the frontier, for bottom-up levels.
+      std::vector<std::uint32_t> frontier;                  //The vertices at the current distance.
+      std::vector<std::vector<std::uint32_t>> blockNext;    //The vertices each block found for the next level.
+      std::unique_ptr<std::atomic<std::uint64_t>[]> expanded; //One bit per movie, set once a bipartite search expands it.
+      std::size_t expandedWords = 0;                        //The number of words in expanded.
+      RunStats* stats = nullptr;                            //Told about each level of ComputeDistances, when set.
+
+      //The two searches of FindPath. A vertex's entries only count when its mark equals stamp, so a new search
+      //starts by moving stamp on instead of clearing every entry, and only pays for the vertices it reaches.
+      std::uint32_t stamp = 0;                        //The mark of the current search.
+      std::vector<std::uint32_t> forwardMark;         //stamp once the search from the first actor/actress reaches a vertex.
+      std::vector<std::uint32_t> backwardMark;        //stamp once the search from the second actor/actress reaches a vertex.
+      std::vector<std::uint32_t> forwardParent;       //The vertex the forward search reached each vertex from.
+      std::vector<std::uint32_t> backwardParent;      //The vertex the backward search reached each vertex from.
+      std::vector<int> forwardDistance;               //Each vertex's distance from the first actor/actress.
+      std::vector<int> backwardDistance;              //Each vertex's distance from the second actor/actress.
+      std::vector<std::uint32_t> forwardFrontier;     //The forward search's current level.
+      std::vector<std::uint32_t> backwardFrontier;    //The backward search's current level.
+      std::vector<std::uint32_t> forwardMovieMark;    //stamp once the forward search expands a movie, in a bipartite graph.
+      std::vector<std::uint32_t> backwardMovieMark;   //stamp once the backward search expands a movie, in a bipartite graph.
+   };
+
+   //Told about each level of a breadth first search as soon as it is found, with its distance and its vertices.
+   //Returning false ends the search at that level.
+   using LevelFound = std::function<bool(int level, const std::vector<std::uint32_t>& found)>;
+
+   //The shortest chain between two actors/actresses found by FindPath.
+   struct Path {
+      int distance = -1;                  //The number of movies in the chain, or -1 if there is no chain.
+      std::vector<std::uint32_t> actors;  //The ids of the actors/actresses along the chain, starting with the first.
+      std::vector<std::uint32_t> movies;  //movies[i] is a movie id shared by actors[i] and actors[i + 1].
+      std::size_t visitedVertices = 0;    //The number of vertices either search reached.
+   };
+
+   //The ways Finalize can number the vertices. Every order but File gives co-stars ids near each other, so a search
+   //touches fewer cache lines of the rows, distances and visited bits as it moves from a vertex to its co-stars.
+   enum class VertexOrder : std::uint32_t {
+      File,               //The order the actors/actresses were added in.
+      Breadth,            //The order a breadth first search reaches them, starting from the most co-stars.
+      Degree,             //The most co-stars first.
+      ReverseCuthillMcKee //Breadth first from the fewest co-stars, taking the co-stars found by fewest first, reversed.
+   };
+
+   //How far one source is from everything it reaches, as measured by MeasureSources.
+   struct SourceStats {
+      std::uint32_t source = NoVertex;  //The id of the source.
+      std::uint64_t reached = 0;        //The number of other vertices the source reaches.
+      std::uint64_t distanceSum = 0;    //The sum of the distances to them.
+      int eccentricity = 0;             //The largest distance to any of them.
+   };
+
    /*
    Purpose:          Construct the graph when Graph is created without arguments.
    Parameters:       None.
@@ -40,16 +109,445 @@ public:
 
    /*
    Purpose:          Add a node Vertex to the graph.
-   Parameters:       inputName, a string that represents the name of an actor/actress.
-                     inputMovies, a vector of strings representing the movies the actor/actress was in.
+   Parameters:       inputName, a string_view that represents the name of an actor/actress.
+                     inputMovies, a vector of string_views representing the movies the actor/actress was in.
                      Both of these are used to construct a Vertex for the Graph, which allows Graph to
                      eventually calculate the Bacon number for this actor/actress.
    Preconditions:    A Graph object has been instantiated.
-   Postconditions:   The Graph object now contains a node Vertex 
+   Postconditions:   The Graph object now contains a node Vertex, and the Vertex is in the cast of each of its movies.
+                     The cost is proportional to the new Vertex's movies rather than to the size of the Graph.
+                     The Graph is no longer frozen, so its edges will be rebuilt by the next Finalize.
+                     A name already in the Graph, and a movie listed twice, are skipped and counted in its RunStats.
+   Return value:     None.
+   Functions Called: Thaw(), which first turns a graph loaded from a snapshot back into vertices.
+                     StringArena::Intern(), which stores the name and each new movie once.
+   */
+   void Add(std::string_view inputName, const std::vector<std::string_view>& inputMovies);
+
+   /*
+   Purpose:          Freeze the graph into a compressed sparse row layout for the breadth-first search.
+                     Each thread builds the rows of one block of vertices, and the blocks are then copied into place.
+                     A bipartite Graph instead freezes each movie's cast as its row.
+   Parameters:       None.
+   Preconditions:    A Graph object has been instantiated.
+   Postconditions:   Every Vertex's id indexes offsets, and its neighbors are the ids stored from neighbors[offsets[id]]
+                     up to neighbors[offsets[id + 1]], in increasing order. In a bipartite Graph it is every movie's id
+                     that indexes offsets, and its row is its cast. Nothing is rebuilt if the Graph is already frozen.
+                     The vertices are first numbered in the order chosen with SetOrder. A compressed Graph instead
+                     packs each row into packed, starting at packed[offsets[id]].
+   Return value:     None.
+   Functions Called: PhaseTimer, which times the freeze when the Graph has RunStats.
+                     Renumber(), which numbers the vertices in the chosen order.
+   */
+   void Finalize();
+
+   /*
+   Purpose:          Choose whether the Graph is frozen as co-star edges or as the movies between actors/actresses.
+                     Co-star edges grow with the square of each cast, so a movie with a cast of 500 costs about 125
+                     thousand edges, while a bipartite Graph keeps each credit once and its searches step from
+                     actors/actresses to their movies and from movies to their casts.
+   Parameters:       enabled, true for the bipartite layout, false for co-star edges.
+   Preconditions:    A Graph object has been instantiated.
+   Postconditions:   The next Finalize freezes the chosen layout. Distances are the same in either layout.
+   Return value:     None.
+   Functions Called: Thaw(), if the Graph was mapped from a snapshot of the other layout.
+   */
+   void SetBipartite(bool enabled);
+
+   /*
+   Purpose:          Choose whether the rows are frozen as 32 bit ids or packed, as PackedRows.h describes. Packed
+                     rows keep the gaps between neighboring ids in 1 to 4 bytes each and are unpacked as the searches
+                     read them, so they take much less memory, most of all once the vertices are numbered with
+                     SetOrder so that co-stars sit close together. The rows of a bipartite Graph are casts of a few
+                     actors/actresses each, so packing them saves little.
+   Parameters:       enabled, true to pack the rows, false for 32 bit ids.
+   Preconditions:    A Graph object has been instantiated.
+   Postconditions:   The next Finalize freezes the rows in the chosen form. Every search gives the same answers either way.
+   Return value:     None.
+   Functions Called: Thaw(), if the Graph was mapped from a snapshot of the other form.
+   */
+   void SetCompressed(bool enabled);
+
+   /*
+   Purpose:          Choose how many threads the Graph uses to freeze itself.
+   Parameters:       count, the number of threads. 0 is treated as 1.
+   Preconditions:    A Graph object has been instantiated.
+   Postconditions:   Later work on the Graph uses up to count threads.
+   Return value:     None.
+   Functions Called: None.
+   */
+   void SetThreadCount(unsigned count);
+
+   /*
+   Purpose:          Choose how the vertices are numbered when the Graph is frozen.
+   Parameters:       newOrder, the order. Every order but File renumbers the vertices, so ids change, but the Graph
+                     remembers the order they were added in, and everything printed by name keeps that order.
+   Preconditions:    A Graph object has been instantiated.
+   Postconditions:   The next Finalize numbers the vertices in newOrder.
+   Return value:     None.
+   Functions Called: Thaw(), if the Graph was mapped from a snapshot of another order.
+   */
+   void SetOrder(VertexOrder newOrder);
+
+   /*
+   Purpose:          Read the name of a VertexOrder, as given to --order.
+   Parameters:       name, one of file, bfs, degree or rcm.
+                     found, set to the order named.
+   Preconditions:    None.
+   Postconditions:   Nothing changes if name is not an order.
+   Return value:     True if name is an order, false otherwise.
+   Functions Called: None.
+   */
+   static bool OrderFromName(std::string_view name, VertexOrder& found);
+
+   /*
+   Purpose:          Give where an actor/actress was in the order the vertices were added, whatever their id now.
+   Parameters:       id, the id of the actor/actress's Vertex.
+   Preconditions:    id is less than VertexCount().
+   Postconditions:   Nothing in the Graph changes.
+   Return value:     The number of vertices added before them.
+   Functions Called: None.
+   */
+   std::uint32_t AddedPosition(std::uint32_t id) const;
+
+   /*
+   Purpose:          Choose where the Graph records the phases it runs, what it skips while adding, and the levels of
+                     the searches operator<< runs.
+   Parameters:       stats, the RunStats to record in, or nullptr to record nothing. It must outlive the Graph's use of it.
+   Preconditions:    A Graph object has been instantiated.
+   Postconditions:   Later work on the Graph is recorded in stats. Nothing is recorded if RunStats are not built.
+   Return value:     None.
+   Functions Called: None.
+   */
+   void SetStats(RunStats* stats);
+
+   /*
+   Purpose:          Give where the Graph records what it does.
+   Parameters:       None.
+   Preconditions:    A Graph object has been instantiated.
+   Postconditions:   Nothing in the Graph changes.
+   Return value:     The RunStats given to SetStats, or nullptr if there is none.
+   Functions Called: None.
+   */
+   RunStats* Stats() const;
+
+   /*
+   Purpose:          Report the memory used by the frozen graph.
+   Parameters:       None.
+   Preconditions:    A Graph object has been instantiated.
+   Postconditions:   Nothing in the Graph changes.
+   Return value:     The largest number of bytes the offsets, rows and scratch arrays occupied while freezing the Graph.
+   Functions Called: None.
+   */
+   std::size_t FrozenPeakBytes() const;
+
+   /*
+   Purpose:          Report the memory the frozen rows take, which is what SetCompressed saves.
+   Parameters:       None.
+   Preconditions:    A Graph object has been instantiated.
+   Postconditions:   Nothing in the Graph changes.
+   Return value:     The bytes of the offsets and the rows, whether they are 32 bit ids or packed, or 0 if the Graph
+                     has not been frozen.
+   Functions Called: None.
+   */
+   std::size_t RowBytes() const;
+
+   /*
+   Purpose:          Report the number of undirected edges in the frozen graph.
+   Parameters:       None.
+   Preconditions:    A Graph object has been instantiated.
+   Postconditions:   Nothing in the Graph changes.
+   Return value:     The number of undirected edges, or 0 if the Graph has not been frozen. The edges of a bipartite
+                     Graph are its credits, each joining an actor/actress to a movie.
+   Functions Called: None.
+   */
+   std::size_t EdgeCount() const;
+
+   /*
+   Purpose:          Report the number of actors/actresses in the graph.
+   Parameters:       None.
+   Preconditions:    A Graph object has been instantiated.
+   Postconditions:   Nothing in the Graph changes.
+   Return value:     The number of vertices, which is one more than the largest id.
+   Functions Called: None.
+   */
+   std::size_t VertexCount() const;
+
+   /*
+   Purpose:          Give the name of an actor/actress.
+   Parameters:       id, the id of the actor/actress's Vertex.
+   Preconditions:    id is less than VertexCount().
+   Postconditions:   Nothing in the Graph changes.
+   Return value:     The name, which stays valid until the Graph next changes.
+   Functions Called: StringArena::Get(), which gives the name.
+   */
+   std::string_view NameOf(std::uint32_t id) const;
+
+   /*
+   Purpose:          Give the name of a movie.
+   Parameters:       movie, the movie's id.
+   Preconditions:    movie is the id of a movie in the Graph.
+   Postconditions:   Nothing in the Graph changes.
+   Return value:     The name as it was cleaned by the parser, which stays valid until the Graph next changes.
+   Functions Called: StringArena::Get(), which gives the name.
+   */
+   std::string_view TitleOf(std::uint32_t movie) const;
+
+   /*
+   Purpose:          Give the movies of an actor/actress.
+   Parameters:       id, the id of the actor/actress's Vertex.
+   Preconditions:    id is less than VertexCount().
+   Postconditions:   Nothing in the Graph changes.
+   Return value:     The movie ids, in the order they were listed, which stay valid until the Graph next changes.
+   Functions Called: None.
+   */
+   ArrayView<std::uint32_t> CreditsOf(std::uint32_t id) const;
+
+   /*
+   Purpose:          Write the frozen graph to a binary snapshot file.
+   Parameters:       path, where the snapshot is written.
+                     sourceSize, the size of the actors list the graph was read from.
+                     sourceModified, when that actors list was last changed.
+                     Both are stored so that LoadSnapshot can reject a snapshot of an older list.
+   Preconditions:    A Graph object has been instantiated.
+   Postconditions:   The Graph is frozen, and the snapshot holds its names, movies, credits and adjacency arrays.
+   Return value:     True if the snapshot was written, false otherwise.
+   Functions Called: Finalize(), which freezes the Graph first.
+   */
+   bool SaveSnapshot(const char* path, std::uint64_t sourceSize, std::int64_t sourceModified);
+
+   /*
+   Purpose:          Replace the graph with one mapped from a binary snapshot file.
+   Parameters:       path, where the snapshot is.
+                     sourceSize, the size the actors list must have had when the snapshot was written.
+                     sourceModified, the time the actors list must have had when the snapshot was written.
+                     verifyPayload, whether to checksum every byte of the snapshot rather than only its header.
+   Preconditions:    A Graph object has been instantiated.
+   Postconditions:   If the snapshot is valid, the Graph is frozen and reads everything from the mapping, with no
+                     per-vertex allocation. Otherwise the Graph is unchanged.
+   Return value:     True if the snapshot was loaded, false if it is missing, of another version or layout, damaged
+                     or stale.
+   Functions Called: None.
+   */
+   bool LoadSnapshot(const char* path, std::uint64_t sourceSize, std::int64_t sourceModified, bool verifyPayload);
+
+   /*
+   Purpose:          Choose the actor/actress whose distances operator<< prints.
+   Parameters:       name, the actor/actress's name as it is written in the actors list.
+   Preconditions:    A Graph object has been instantiated.
+   Postconditions:   operator<< measures from name instead of from Kevin Bacon.
+   Return value:     None.
+   Functions Called: None.
+   */
+   void SetCenter(std::string_view name);
+
+   /*
+   Purpose:          Choose whether operator<< prints the distances as the search finds them or sorted, as SortedOutput.h
+                     describes. Sorted output gives each name in the order first name last name and depends on nothing
+                     but the names and distances, but cannot print anything until the search is done.
+   Parameters:       enabled, true to sort, false to print each level as it is found.
+   Preconditions:    A Graph object has been instantiated.
+   Postconditions:   operator<< and LiveGraph::Write print in the chosen way.
+   Return value:     None.
+   Functions Called: None.
+   */
+   void SetSortedOutput(bool enabled);
+
+   /*
+   Purpose:          Give whether operator<< prints the distances sorted.
+   Parameters:       None.
+   Preconditions:    A Graph object has been instantiated.
+   Postconditions:   Nothing in the Graph changes.
+   Return value:     True if SetSortedOutput chose sorted output, false otherwise.
+   Functions Called: None.
+   */
+   bool SortedOutput() const;
+
+   /*
+   Purpose:          Find an actor/actress's Vertex by name, through the name hash table, so the cost does not grow
+                     with the size of the Graph.
+   Parameters:       name, the actor/actress's name as it is written in the actors list.
+   Preconditions:    The Graph object has been instantiated.
+   Postconditions:   Nothing in the Graph changes.
+   Return value:     The id of the Vertex, or NoVertex if no actor/actress has that name.
+   Functions Called: StringArena::Find(), which looks the name up.
+   */
+   std::uint32_t Find(std::string_view name) const;
+
+   /*
+   Purpose:          Find a movie's id by name, through the movie hash table.
+   Parameters:       title, the movie's name as it was cleaned by the parser.
+   Preconditions:    The Graph object has been instantiated.
+   Postconditions:   Nothing in the Graph changes.
+   Return value:     The id of the movie, or NoVertex if no movie has that name.
+   Functions Called: StringArena::Find(), which looks the name up.
+   */
+   std::uint32_t FindMovie(std::string_view title) const;
+
+   /*
+   Purpose:          Report the number of distinct movies in the graph.
+   Parameters:       None.
+   Preconditions:    A Graph object has been instantiated.
+   Postconditions:   Nothing in the Graph changes.
+   Return value:     The number of movies, which is one more than the largest movie id.
+   Functions Called: None.
+   */
+   std::size_t MovieCount() const;
+
+   /*
+   Purpose:          Give the name of the actor/actress operator<< measures distances from.
+   Parameters:       None.
+   Preconditions:    A Graph object has been instantiated.
+   Postconditions:   Nothing in the Graph changes.
+   Return value:     The name, which is Kevin Bacon's unless SetCenter chose another.
+   Functions Called: None.
+   */
+   const std::string& CenterName() const;
+
+   /*
+   Purpose:          Find every actor/actress whose name matches text with case ignored, either exactly or as a
+                     prefix, so "bacon, kevin" finds "Bacon, Kevin (I)". The names are binary searched in their
+                     sorted order, so the cost grows with the log of the number of vertices and the number of matches.
+   Parameters:       text, what the names are matched against.
+                     prefix, true if names need only start with text, false if they must equal it.
+                     matches, cleared and then filled with the ids that match, in the order of their names.
+   Preconditions:    The Graph object has been instantiated and frozen.
+   Postconditions:   Nothing in the Graph changes.
    Return value:     None.
+   Functions Called: NameOf(), which gives the names compared.
+   */
+   void FindMatching(std::string_view text, bool prefix, std::vector<std::uint32_t>& matches) const;
+
+   /*
+   Purpose:          Give the number of threads the Graph was told to use.
+   Parameters:       None.
+   Preconditions:    A Graph object has been instantiated.
+   Postconditions:   Nothing in the Graph changes.
+   Return value:     The thread count, which is at least 1.
    Functions Called: None.
    */
-   void Add(std::string inputName, std::vector<std::string> inputMovies);
+   unsigned ThreadCount() const;
+
+   /*
+   Purpose:          Print every actor/actress and their distance from a center on seperate lines. Each distance is
+                     printed and flushed as soon as the breadth first search finds it, so the first lines appear at
+                     once and the output never needs more memory than the writer's buffer.
+   Parameters:       start, the id of the center Vertex. This is used to start the breadth first search.
+                     scratch, the space the search works in.
+                     threads, the number of threads the search uses.
+                     out, the writer the lines are printed through.
+   Preconditions:    The Graph object has been instantiated and frozen, and start is a Vertex of it.
+   Postconditions:   Nothing in the Graph changes, and every line has been given to out.
+   Return value:     None. The lines are formatted according to specifications, and actors/actresses with the same
+                     distance are listed in the order they were added.
+   Functions Called: ComputeDistances(), which runs the breadth first search and hands over each level.
+   */
+   void GenerateNumbers(std::uint32_t start, SearchScratch& scratch, unsigned threads, OutputWriter& out) const;
+
+   /*
+   Purpose:          Print every actor/actress and their distance from a center on seperate lines, sorted by distance
+                     and then by name in the order first name last name, with those who cannot be reached last.
+   Parameters:       start, the id of the center Vertex. This is used to start the breadth first search.
+                     scratch, the space the search works in.
+                     threads, the number of threads the search and the sort use.
+                     out, the writer the lines are printed through.
+   Preconditions:    The Graph object has been instantiated and frozen, and start is a Vertex of it.
+   Postconditions:   Nothing in the Graph changes, and every line has been given to out.
+   Return value:     None.
+   Functions Called: ComputeDistances(), which runs the breadth first search, and WriteSorted(), which sorts and prints
+                     the lines.
+   */
+   void GenerateSortedNumbers(std::uint32_t start, SearchScratch& scratch, unsigned threads, OutputWriter& out) const;
+
+   /*
+   Purpose:          Find the distance from one vertex to every other with a parallel, level by level breadth first search.
+                     Each level is expanded either top-down, where every frontier vertex claims its unvisited neighbors,
+                     or bottom-up, where every unvisited vertex looks for any neighbor in the frontier and stops at the
+                     first it finds. Bottom-up wins when the frontier holds a large share of the remaining edges, which
+                     happens at the middle levels of the co-star graph. A bipartite Graph is searched by
+                     SearchByMovie instead.
+   Parameters:       start, the id of the vertex the search starts from.
+                     scratch, the space the search works in. Its distances are left holding the distance of every vertex
+                     from start, or -1 if it cannot be reached.
+                     threads, the number of threads the search uses.
+                     levelFound, if it is not empty, called with each level, starting with the level of start alone,
+                     as soon as the level is found. Its vertices are in no particular order. It returns false to end
+                     the search there, leaving every vertex farther away at -1, and true to go on.
+   Preconditions:    The Graph object has been instantiated and frozen.
+   Postconditions:   Nothing in the Graph changes, so any number of searches with their own scratch may run at once.
+   Return value:     None.
+   Functions Called: ParallelFor(), which splits each level across the threads, and levelFound.
+                     SearchByMovie(), which searches a bipartite Graph.
+   */
+   void ComputeDistances(std::uint32_t start, SearchScratch& scratch, unsigned threads, const LevelFound& levelFound) const;
+
+   /*
+   Purpose:          Find the distances from a center to a few actors/actresses, searching only as far as the farthest of
+                     them. The search stops at the level where the last of them is found, rather than going on to reach
+                     everything, so asking about near neighbors costs a small part of a whole search.
+   Parameters:       start, the id of the center.
+                     targets, the ids of the actors/actresses asked about.
+                     scratch, the space the search works in. Its distances are left holding every distance the search
+                     found, and -1 for every vertex it did not reach.
+                     threads, the number of threads the search uses.
+                     distances, set to one distance for each target, in the order of targets, or -1 if it cannot be reached.
+   Preconditions:    The Graph object has been instantiated and frozen, and start and every target are vertices of it.
+   Postconditions:   Nothing in the Graph changes.
+   Return value:     True if the search reached everything it could, so every -1 left in scratch's distances cannot be
+                     reached. False if it stopped early, so a -1 there may only be farther than the search went.
+   Functions Called: ComputeDistances(), which runs the search and stops it once every target has a distance.
+   */
+   bool DistancesTo(std::uint32_t start, const std::vector<std::uint32_t>& targets, SearchScratch& scratch, unsigned threads,
+                    std::vector<int>& distances) const;
+
+   /*
+   Purpose:          Find the shortest chain of actor, shared movie, actor between two actors/actresses with a
+                     bidirectional breadth first search. A search grows from each end, always growing whichever has
+                     the smaller frontier by one whole level, until the two meet. Only the vertices near the two
+                     ends are reached, rather than everything a search from one end would reach. In a bipartite
+                     Graph each search steps through movies, expanding each movie at most once.
+   Parameters:       from, the id of the first actor/actress.
+                     to, the id of the second actor/actress.
+                     scratch, the space the search works in.
+                     path, filled with the chain, its length and the number of vertices reached.
+   Preconditions:    The Graph object has been instantiated and frozen, and from and to are vertices of it.
+   Postconditions:   Nothing in the Graph changes, so any number of searches with their own scratch may run at once.
+   Return value:     None.
+   Functions Called: CreditsOf(), to pick a movie shared by each pair of actors/actresses along the chain.
+   */
+   void FindPath(std::uint32_t from, std::uint32_t to, SearchScratch& scratch, Path& path) const;
+
+   /*
+   Purpose:          Measure the distances from many sources at once with a bit-parallel, multi-source breadth first
+                     search. Each vertex keeps one bit per source of a batch, in words that are ORed together, so one
+                     pass over the edges advances every source of the batch by a level. Each level has every vertex
+                     gather the bits of its neighbors, so the blocks of vertices can be split across the threads
+                     without sharing anything they write. In a bipartite Graph each level first has every movie
+                     gather the bits of its cast, then every vertex gather the bits of its movies.
+   Parameters:       sources, the ids of the sources.
+                     stats, cleared and then filled with one entry per source, in the order of sources.
+                     threads, the number of threads the search uses.
+   Preconditions:    The Graph object has been instantiated and frozen, and every source is a vertex of it.
+   Postconditions:   Nothing in the Graph changes.
+   Return value:     None.
+   Functions Called: ParallelFor(), which splits each level across the threads.
+   */
+   void MeasureSources(const std::vector<std::uint32_t>& sources, std::vector<SourceStats>& stats, unsigned threads) const;
+
+   /*
+   Purpose:          Rank the actors/actresses with the most co-stars as centers of the Graph. Each is printed on its
+                     own line as name, average distance, eccentricity and the number of others reached, separated by
+                     tabs. Those reaching more come first, and those reaching the same number are ranked by average
+                     distance, so the first line is the best center of the largest connected part of the Graph.
+   Parameters:       count, the number of actors/actresses to rank.
+                     threads, the number of threads the search uses.
+                     out, the writer the ranking is printed through.
+   Preconditions:    The Graph object has been instantiated and frozen.
+   Postconditions:   Nothing in the Graph changes, and every line has been given to out.
+   Return value:     None.
+   Functions Called: MeasureSources(), which measures every source.
+   */
+   void RankCenters(std::size_t count, unsigned threads, OutputWriter& out) const;
 
    /*
    Purpose:          Output the Bacon numbers for each actor/actress according to specifications.
@@ -59,70 +557,134 @@ public:
    Postconditions:   If the Graph is empty, print a statement that Graph is empty.
                      Otherwise, display each actor/actress and their Bacon Number according to specifications.
    Return value:     out, an ostream to allow statements to be chained according to operator<<'s specification.
-   Functions Called: GenerateNumbers(), a function that generates the string of actors/actresses and their Bacon
-                     number based on specifications to be sent to terminal.
-                     FindKevinBacon(), a function that returns the location of the Kevin Bacon Vertex.
-                     This function prints GenerateNumbers, which requires FindKevinBacon to print the degree's of
-                     seperation from Kevin Bacon.
+   Functions Called: GenerateNumbers(), a function that prints the actors/actresses and their Bacon number based
+                     on specifications through an OutputWriter on out, a level at a time, or GenerateSortedNumbers()
+                     if SetSortedOutput chose sorted output.
+                     Find(), a function that returns the location of the Kevin Bacon Vertex, or of the center chosen
+                     with SetCenter. This function prints GenerateNumbers, which requires Find to print the degree's
+                     of seperation from Kevin Bacon.
    */
    friend std::ostream& operator<<(std::ostream& out, Graph& graph);
 private:
-   struct Vertex {
-
-      /*
-      Purpose:          Construct the node when Vertex is created without arguments.
-      Parameters:       None.
-      Preconditions:    This specific Vertex object has not been instantiated.
-      Postconditions:   Vertex object has been instantiated with default values.
-      Return value:     None.
-      Functions Called: None.
-      */
-      Vertex();
-
-      /*
-      Purpose:          Construct the node when Vertex is created with arguments.
-      Parameters:       inputName, a string that is an actor/actress's name.
-                        inputMovies, a vector of strings, each representing a move that actor/actress was in.
-                        these are used to create the Vertex object that will be used to find the actor/actress's
-                        Bacon number.
-      Preconditions:    This specific Vertex object has not been instantiated.
-      Postconditions:   Vertex object has been instantiated with default values excluding given values.
-      Return value:     None.
-      Functions Called: None.
-      */
-      Vertex(std::string inputName, std::vector<std::string> inputMovies);
-
-      //Variables
-      int distanceFromBacon;           //The distance from Kevin Bacon.
-      std::string name;                //The name of the act or this vertex belongs to.
-      std::vector<std::string> movies; //The list of movies that is associated with the actor.
-      std::list<Vertex*> edges;        //The list of vertices connected to this vertex.
-      bool visited;
-   };
-   std::list<Vertex*> vertices;        //This is the list of vertices pointers in the graph. Each vertex contains its edges.
-                                       //It is a list because a vector will change memory locations, breaking pointers.
-                                       //I use pointers for this becuase it is quite difficult to do Add with my design without
-                                       //these being pointers, the for loop iteration is a temporary variable rather than
-                                       //The actual nodes.
+   //The vertices. A Vertex is known by its id: its name is names.Get(id), and its movies are its row of the credit
+   //table. Adding a Vertex appends to these tables instead of allocating anything of its own, and every name and
+   //movie is stored once however many credits mention it.
+   StringArena names;                     //Every name, with a Vertex's id as the name's id.
+   StringArena titles;                    //Every distinct movie, with the movie's id as the title's id.
+   ArrayView<std::uint64_t> creditOffsets; //Where each Vertex's movie ids start in creditIds, with one extra entry at the end.
+   ArrayView<std::uint32_t> creditIds;     //Every Vertex's movie ids, one row after another.
+   std::vector<std::uint64_t> creditOffsetStorage; //The credit offsets built by Add.
+   std::vector<std::uint32_t> creditIdStorage;     //The credits built by Add.
+   std::vector<std::vector<std::uint32_t>> casts; //The movie to cast index. Each entry lists, in increasing order, the
+                                                  //ids of every actor/actress that was in that movie.
+
+   unsigned threadCount;                 //The most threads the Graph uses at once.
+   std::string centerName;               //The actor/actress operator<< measures distances from.
+   bool sortedOutput;                    //True when operator<< prints the distances sorted.
+   RunStats* stats;                      //Where the Graph records what it does, or nullptr.
+
+   //The frozen graph. Rebuilt by Finalize whenever a Vertex has been added since the last freeze.
+   bool frozen;                          //True when offsets and neighbors describe every Vertex.
+   bool bipartite;                       //True when the rows are each movie's cast rather than each Vertex's co-stars.
+   bool compressed;                      //True when the rows are packed rather than kept as 32 bit ids.
+   ArrayView<std::uint64_t> offsets;     //Where each row starts in neighbors, or in packed, with one extra entry at the end.
+   ArrayView<std::uint32_t> neighbors;   //Every Vertex's neighbors, or every movie's cast, one row after another.
+   ArrayView<std::uint8_t> packed;       //The same rows packed, followed by PackedPadding bytes, in a compressed Graph.
+   std::uint64_t rowEntries;             //The ids in every row together, however they are stored.
+   std::vector<std::uint64_t> offsetStorage;   //The offsets built by Finalize.
+   std::vector<std::uint32_t> neighborStorage; //The neighbors built by Finalize.
+   std::vector<std::uint8_t> packedStorage;    //The packed rows built by Finalize.
+   std::size_t frozenPeakBytes;          //The most memory the frozen arrays and their scratch space used while freezing.
+
+   //A loaded snapshot. While one is mapped, casts is empty and every table above is read from the mapping.
+   MappedFile snapshot;
+
+   //The sorted name order, which is kept in the snapshot too so that a mapped graph does not rebuild it.
+   ArrayView<std::uint32_t> nameOrder;          //Every id, sorted by name with case ignored. Rebuilt by Finalize.
+   std::vector<std::uint32_t> nameOrderStorage; //The order built by Finalize.
+
+   //The numbering of the vertices, which is kept in the snapshot too.
+   VertexOrder order;                            //The order the next Finalize numbers the vertices in.
+   ArrayView<std::uint32_t> addedOrder;          //Every id's AddedPosition, or empty when every id is its position.
+   std::vector<std::uint32_t> addedOrderStorage; //The positions built by Renumber and Add.
 
    /*
-   Purpose:          Generate a string that contains every actor/actress and their bacon number on seperate lines.
-   Parameters:       start, a pointer to a Vertex. This is used to start the breadth first search.
-   Preconditions:    The Graph object has been instantiated.
-   Postconditions:   Nothing in the Graph changes, and a string is returned to operator<< for printing.
-   Return value:     A string that contains every actor/actress and their Bacon number properly formatted according to specifications.
-   Functions Called: None.
+   Purpose:          Turn a graph loaded from a snapshot back into vertices that can be added to.
+   Parameters:       None.
+   Preconditions:    A snapshot is mapped.
+   Postconditions:   The Graph owns copies of the snapshot's names, movies and credits, casts is rebuilt from the
+                     credits, nothing is mapped, and the Graph is no longer frozen.
+   Return value:     None.
+   Functions Called: StringArena::Own(), which copies the names and movies out of the mapping.
    */
-   std::string GenerateNumbers(Vertex* start);
+   void Thaw();
 
    /*
-   Purpose:          Find the Kevin Bacon Vertex in the Graph.
+   Purpose:          Number the vertices in the chosen order. The order is found by walking the credits and casts, so
+                     it can be chosen before the rows are built, and every table indexed by a Vertex's id is moved
+                     to its new id. A vertex's co-stars are counted through its movies, so one shared twice counts twice.
    Parameters:       None.
-   Preconditions:    The Graph object has been instantiated.
-   Postconditions:   Nothing in the Graph changes, and a pointer to either null or the Bacon Vertex is returned.
-   Return value:     A pointer to either null or the Bacon Vertex is returned. Nullptr is returned if Kevin Bacon does not exist, otherwise
-                     the pointer points to the Kevin Bacon Vertex.
-   Functions Called: None.
+   Preconditions:    The Graph owns its tables, rather than reading them from a mapping.
+   Postconditions:   The names, credits and casts are in the new numbering, each cast still in increasing order, and
+                     AddedPosition gives every Vertex's place in the order they were added. The frozen rows are not
+                     touched, since Finalize builds them next.
+   Return value:     None.
+   Functions Called: StringArena::Clear() and StringArena::Intern(), which store the names again in their new order.
+                     ParallelFor(), which renumbers and sorts the casts.
+   */
+   void Renumber();
+
+   /*
+   Purpose:          Find the distance from one vertex to every other in a bipartite Graph, a level at a time. Each
+                     level has the frontier's actors/actresses claim their movies, and each movie claimed expands its
+                     cast, so every movie is expanded at most once and a search costs time proportional to the credits.
+   Parameters:       scratch, the space the search works in, with the start alone in its frontier. Its distances are
+                     left as ComputeDistances leaves them.
+                     threads, the number of threads the search uses.
+                     levelFound, if it is not empty, called with each level as ComputeDistances calls it, and ending
+                     the search when it returns false.
+   Preconditions:    The Graph object has been instantiated and frozen as a bipartite Graph, and scratch has been
+                     prepared by ComputeDistances.
+   Postconditions:   Nothing in the Graph changes.
+   Return value:     None.
+   Functions Called: ParallelFor(), which splits each level across the threads, and levelFound.
+   */
+   void SearchByMovie(SearchScratch& scratch, unsigned threads, const LevelFound& levelFound) const;
+
+   /*
+   Purpose:          Hand each id of a frozen row to visit in increasing order, until visit asks to stop, whether the
+                     row is kept as 32 bit ids or packed.
+   Parameters:       row, the id of the Vertex, or of the movie in a bipartite Graph, whose row is read.
+                     visit, called as visit(id) for each id. It returns false to stop, true to go on.
+   Preconditions:    The Graph object has been instantiated and frozen.
+   Postconditions:   Nothing in the Graph changes.
+   Return value:     False if visit stopped the row early, true otherwise.
+   Functions Called: ForEachPacked(), which unpacks a packed row, and visit.
+   */
+   template <typename Visit>
+   bool ForEachInRow(std::size_t row, Visit visit) const {
+      if (compressed) {
+         return ForEachPacked(packed.begin() + offsets[row], visit);
+      }
+      for (std::uint64_t edge = offsets[row]; edge < offsets[row + 1]; edge++) {
+         //Every id of this row has not been visited yet.
+
+         if (!visit(neighbors[edge])) {
+            return false;
+         }
+      }
+      return true;
+   }
+
+   /*
+   Purpose:          Give the number of ids in a frozen row, without reading them.
+   Parameters:       row, the id of the Vertex, or of the movie in a bipartite Graph.
+   Preconditions:    The Graph object has been instantiated and frozen.
+   Postconditions:   Nothing in the Graph changes.
+   Return value:     The number of ids in the row.
+   Functions Called: PackedRowCount(), which reads the length of a packed row.
    */
-   Vertex* FindKevinBacon();
+   std::uint64_t RowLength(std::size_t row) const {
+      return compressed ? PackedRowCount(packed.begin() + offsets[row]) : offsets[row + 1] - offsets[row];
+   }
 };
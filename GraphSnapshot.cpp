@@ -0,0 +1,300 @@
+/*
+File Name:  GraphSnapshot.cpp
+Author:     Logan Petersen
+Date:       Febuary 2, 2020
+Purpose:    The purpose of this code is to be the function definitions for
+            the prototypes in GraphSnapshot.h, along with Graph's SaveSnapshot
+            and LoadSnapshot. A snapshot is written to a temporary file that is
+            renamed over the old one once complete, so a reader never maps a
+            half written snapshot.
+*/
+
+#include "GraphSnapshot.h"
+#include "Graph.h"
+#include <cstring>    //Grants memcpy and memcmp, for reading and checking the header.
+#include <cstdio>     //Grants rename and remove, for replacing the old snapshot.
+#include <fstream>    //Grants file writing, for writing the snapshot.
+#include <filesystem> //Grants file_size and last_write_time, which stamp a snapshot with its actors list.
+
+namespace {
+
+   /*
+   Purpose:          Write one section of a snapshot, padded with zeroes, and fold it into the checksum.
+   Parameters:       file, the snapshot being written.
+                     data, the bytes of the section.
+                     size, the number of bytes.
+                     checksum, the payload checksum so far, which is updated.
+   Preconditions:    file is open for binary writing.
+   Postconditions:   The section and its padding have been written.
+   Return value:     None.
+   Functions Called: SnapshotChecksum(), which folds the section into checksum.
+   */
+   void WriteSection(std::ofstream& file, const void* data, std::size_t size, std::uint64_t& checksum) {
+      const char padding[8] = {};
+
+      file.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+      file.write(padding, static_cast<std::streamsize>(SnapshotPadded(size) - size));
+      checksum = SnapshotChecksum(checksum, data, size);
+   }
+}
+
+/*
+Purpose:          Fold bytes into a running snapshot checksum, 8 bytes at a time.
+Parameters:       checksum, the checksum so far. Start it at SnapshotChecksumSeed.
+                  data, the bytes to fold in.
+                  size, the number of bytes. The last 8 byte word is padded with zeroes, as sections are on disk.
+Preconditions:    None.
+Postconditions:   Nothing changes.
+Return value:     The checksum with the bytes folded in.
+Functions Called: None.
+*/
+std::uint64_t SnapshotChecksum(std::uint64_t checksum, const void* data, std::size_t size) {
+
+   //Local Variables
+   const unsigned char* bytes = static_cast<const unsigned char*>(data);
+   std::uint64_t word;
+
+   for (std::size_t i = 0; i < size; i += 8) {
+      //Every 8 byte word has not been folded in yet.
+
+      word = 0;
+      std::memcpy(&word, bytes + i, size - i < 8 ? size - i : 8);
+
+      //An FNV style step over whole words, with a shift so high bits reach the low ones.
+      checksum = (checksum ^ word) * 0x100000001b3;
+      checksum ^= checksum >> 29;
+   }
+   return checksum;
+}
+
+/*
+Purpose:          Find the size and last change time of the actors list a snapshot is made from.
+Parameters:       path, the location of the actors list.
+                  size, set to the size of the file in bytes.
+                  modified, set to when the file was last changed, in the file system's own units.
+Preconditions:    None.
+Postconditions:   Nothing changes.
+Return value:     True if the file exists and both could be found, false otherwise.
+Functions Called: None.
+*/
+bool SnapshotSourceStamp(const char* path, std::uint64_t& size, std::int64_t& modified) {
+
+   //Local Variables
+   std::error_code error;
+   std::uintmax_t fileSize = std::filesystem::file_size(path, error);
+
+   if (error) {
+      return false;
+   }
+   std::filesystem::file_time_type time = std::filesystem::last_write_time(path, error);
+   if (error) {
+      return false;
+   }
+   size = static_cast<std::uint64_t>(fileSize);
+   modified = static_cast<std::int64_t>(time.time_since_epoch().count());
+   return true;
+}
+
+/*
+Purpose:          Write the frozen graph to a binary snapshot file.
+Parameters:       path, where the snapshot is written.
+                  sourceSize, the size of the actors list the graph was read from.
+                  sourceModified, when that actors list was last changed.
+                  Both are stored so that LoadSnapshot can reject a snapshot of an older list.
+Preconditions:    A Graph object has been instantiated.
+Postconditions:   The Graph is frozen, and the snapshot holds its names, name index, movies, credits and adjacency
+                  arrays.
+Return value:     True if the snapshot was written, false otherwise.
+Functions Called: Finalize(), which freezes the Graph first.
+                  WriteSection(), which writes each section.
+*/
+bool Graph::SaveSnapshot(const char* path, std::uint64_t sourceSize, std::int64_t sourceModified) {
+
+   //Local Variables
+   std::string temporaryPath = std::string(path) + ".tmp";
+   std::ofstream file(temporaryPath, std::ios::binary | std::ios::trunc);
+   SnapshotHeader header = {};
+   std::uint64_t checksum = SnapshotChecksumSeed;
+
+   if (!file) {
+      return false;
+   }
+   Finalize();
+   PhaseTimer timer(stats, "save snapshot");
+
+   std::memcpy(header.magic, SnapshotMagic, sizeof(header.magic));
+   header.version = SnapshotVersion;
+   header.byteOrder = SnapshotByteOrder;
+   header.sourceSize = sourceSize;
+   header.sourceModified = sourceModified;
+   header.vertexCount = VertexCount();
+   header.titleCount = titles.Size();
+   header.neighborCount = rowEntries;
+   header.bipartite = bipartite ? 1 : 0;
+   header.compressed = compressed ? 1 : 0;
+   header.packedBytes = packed.size();
+   header.creditCount = creditIds.size();
+   header.order = static_cast<std::uint64_t>(order);
+   header.nameBytes = names.Bytes().size();
+   header.titleBytes = titles.Bytes().size();
+   header.nameSlotCount = names.Slots().size();
+   header.titleSlotCount = titles.Slots().size();
+
+   //The header is written again once the checksum is known.
+   file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+   //Every table is already laid out as it is stored, so each is written as it is.
+   WriteSection(file, names.Offsets().begin(), names.Offsets().size() * sizeof(std::uint64_t), checksum);
+   WriteSection(file, names.Bytes().begin(), names.Bytes().size(), checksum);
+   WriteSection(file, names.Slots().begin(), names.Slots().size() * sizeof(std::uint32_t), checksum);
+   WriteSection(file, nameOrder.begin(), nameOrder.size() * sizeof(std::uint32_t), checksum);
+   WriteSection(file, titles.Offsets().begin(), titles.Offsets().size() * sizeof(std::uint64_t), checksum);
+   WriteSection(file, titles.Bytes().begin(), titles.Bytes().size(), checksum);
+   WriteSection(file, titles.Slots().begin(), titles.Slots().size() * sizeof(std::uint32_t), checksum);
+   WriteSection(file, offsets.begin(), offsets.size() * sizeof(std::uint64_t), checksum);
+   WriteSection(file, neighbors.begin(), neighbors.size() * sizeof(std::uint32_t), checksum);
+   WriteSection(file, packed.begin(), packed.size(), checksum);
+   WriteSection(file, creditOffsets.begin(), creditOffsets.size() * sizeof(std::uint64_t), checksum);
+   WriteSection(file, creditIds.begin(), creditIds.size() * sizeof(std::uint32_t), checksum);
+   WriteSection(file, addedOrder.begin(), addedOrder.size() * sizeof(std::uint32_t), checksum);
+
+   header.payloadChecksum = checksum;
+   header.headerChecksum = SnapshotChecksum(SnapshotChecksumSeed, &header, offsetof(SnapshotHeader, headerChecksum));
+   file.seekp(0);
+   file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+   file.close();
+   if (!file) {
+      std::remove(temporaryPath.c_str());
+      return false;
+   }
+
+   //Replace the old snapshot only now that the new one is complete.
+   std::remove(path);
+   return std::rename(temporaryPath.c_str(), path) == 0;
+}
+
+/*
+Purpose:          Replace the graph with one mapped from a binary snapshot file.
+Parameters:       path, where the snapshot is.
+                  sourceSize, the size the actors list must have had when the snapshot was written.
+                  sourceModified, the time the actors list must have had when the snapshot was written.
+                  verifyPayload, whether to checksum every byte of the snapshot rather than only its header.
+Preconditions:    A Graph object has been instantiated.
+Postconditions:   If the snapshot is valid, the Graph is frozen and reads everything from the mapping, with no
+                  per-vertex allocation. Otherwise the Graph is unchanged.
+Return value:     True if the snapshot was loaded, false if it is missing, of another version or layout, damaged
+                  or stale.
+Functions Called: SnapshotChecksum(), which checks the header and, if asked, the payload.
+                  StringArena::Map(), which reads the names and movies from the mapping.
+*/
+bool Graph::LoadSnapshot(const char* path, std::uint64_t sourceSize, std::int64_t sourceModified, bool verifyPayload) {
+
+   //Local Variables
+   MappedFile mapping;
+   SnapshotHeader header;
+   std::size_t position = sizeof(SnapshotHeader); //Where the next section starts.
+   std::size_t expectedSize = sizeof(SnapshotHeader);
+   std::uint64_t rowCount;                        //The number of rows, one per vertex, or one per movie if bipartite.
+   std::uint64_t addedCount;                      //The number of added positions, none for a graph in file order.
+   std::uint64_t neighborCount;                   //The number of entries in neighbors, none for a compressed graph.
+   PhaseTimer timer(stats, "load snapshot");
+
+   if (!mapping.Open(path) || mapping.Size() < sizeof(SnapshotHeader)) {
+      return false;
+   }
+   std::memcpy(&header, mapping.Data(), sizeof(header));
+
+   //Reject snapshots of another format, another machine, another actors list, the other layout or form of rows or
+   //another order.
+   if (std::memcmp(header.magic, SnapshotMagic, sizeof(header.magic)) != 0 || header.version != SnapshotVersion ||
+       header.byteOrder != SnapshotByteOrder ||
+       header.headerChecksum != SnapshotChecksum(SnapshotChecksumSeed, &header, offsetof(SnapshotHeader, headerChecksum)) ||
+       header.sourceSize != sourceSize || header.sourceModified != sourceModified || header.bipartite != (bipartite ? 1u : 0u) ||
+       header.compressed != (compressed ? 1u : 0u) || header.order != static_cast<std::uint64_t>(order)) {
+      return false;
+   }
+
+   //Every count must fit in the file before the sizes are added up, so the sum cannot overflow.
+   if (header.vertexCount >= mapping.Size() / 8 || header.titleCount >= mapping.Size() / 8 ||
+       (header.compressed == 0 && header.neighborCount > mapping.Size() / 4) || header.creditCount > mapping.Size() / 4 ||
+       header.nameBytes > mapping.Size() || header.titleBytes > mapping.Size() || header.packedBytes > mapping.Size() ||
+       header.vertexCount >= NoVertex || header.nameSlotCount > mapping.Size() / 4 || header.titleSlotCount > mapping.Size() / 4) {
+      return false;
+   }
+
+   //The hash tables must have room for every string with an empty slot left over, or a search of them would never stop.
+   if ((header.nameSlotCount & (header.nameSlotCount - 1)) != 0 || header.nameSlotCount < 2 * header.vertexCount ||
+       (header.titleSlotCount & (header.titleSlotCount - 1)) != 0 || header.titleSlotCount < 2 * header.titleCount) {
+      return false;
+   }
+   rowCount = header.bipartite != 0 ? header.titleCount : header.vertexCount;
+   addedCount = header.order != static_cast<std::uint64_t>(VertexOrder::File) ? header.vertexCount : 0;
+   neighborCount = header.compressed != 0 ? 0 : header.neighborCount;
+   expectedSize += 2 * SnapshotPadded((header.vertexCount + 1) * sizeof(std::uint64_t)) + SnapshotPadded((rowCount + 1) * sizeof(std::uint64_t)) +
+                   SnapshotPadded(header.nameBytes) + SnapshotPadded(header.nameSlotCount * sizeof(std::uint32_t)) +
+                   SnapshotPadded(header.vertexCount * sizeof(std::uint32_t)) + SnapshotPadded((header.titleCount + 1) * sizeof(std::uint64_t)) +
+                   SnapshotPadded(header.titleBytes) + SnapshotPadded(header.titleSlotCount * sizeof(std::uint32_t)) +
+                   SnapshotPadded(neighborCount * sizeof(std::uint32_t)) + SnapshotPadded(header.packedBytes) +
+                   SnapshotPadded(header.creditCount * sizeof(std::uint32_t)) + SnapshotPadded(addedCount * sizeof(std::uint32_t));
+   if (expectedSize != mapping.Size()) {
+      return false;
+   }
+   if (verifyPayload &&
+       header.payloadChecksum != SnapshotChecksum(SnapshotChecksumSeed, mapping.Data() + position, mapping.Size() - position)) {
+      return false;
+   }
+
+   //Every section is viewed where it lies in the mapping.
+   auto section = [&mapping, &position](std::size_t bytes) {
+      const char* start = mapping.Data() + position;
+      position += SnapshotPadded(bytes);
+      return start;
+   };
+   ArrayView<std::uint64_t> newNameOffsets(reinterpret_cast<const std::uint64_t*>(section((header.vertexCount + 1) * 8)), header.vertexCount + 1);
+   ArrayView<char> newNameBytes(section(header.nameBytes), header.nameBytes);
+   ArrayView<std::uint32_t> newNameSlots(reinterpret_cast<const std::uint32_t*>(section(header.nameSlotCount * 4)), header.nameSlotCount);
+   ArrayView<std::uint32_t> newNameOrder(reinterpret_cast<const std::uint32_t*>(section(header.vertexCount * 4)), header.vertexCount);
+   ArrayView<std::uint64_t> newTitleOffsets(reinterpret_cast<const std::uint64_t*>(section((header.titleCount + 1) * 8)), header.titleCount + 1);
+   ArrayView<char> newTitleBytes(section(header.titleBytes), header.titleBytes);
+   ArrayView<std::uint32_t> newTitleSlots(reinterpret_cast<const std::uint32_t*>(section(header.titleSlotCount * 4)), header.titleSlotCount);
+   ArrayView<std::uint64_t> newOffsets(reinterpret_cast<const std::uint64_t*>(section((rowCount + 1) * 8)), rowCount + 1);
+   ArrayView<std::uint32_t> newNeighbors(reinterpret_cast<const std::uint32_t*>(section(neighborCount * 4)), neighborCount);
+   ArrayView<std::uint8_t> newPacked(reinterpret_cast<const std::uint8_t*>(section(header.packedBytes)), header.packedBytes);
+   ArrayView<std::uint64_t> newCreditOffsets(reinterpret_cast<const std::uint64_t*>(section((header.vertexCount + 1) * 8)), header.vertexCount + 1);
+   ArrayView<std::uint32_t> newCreditIds(reinterpret_cast<const std::uint32_t*>(section(header.creditCount * 4)), header.creditCount);
+   ArrayView<std::uint32_t> newAddedOrder(reinterpret_cast<const std::uint32_t*>(section(addedCount * 4)), addedCount);
+
+   //The last offset of every table must match its section, or the tables would be read past their ends. Packed rows
+   //must be followed by their padding.
+   if (newNameOffsets.back() != header.nameBytes || newTitleOffsets.back() != header.titleBytes ||
+       (header.compressed != 0 ? header.packedBytes < PackedPadding || newOffsets.back() != header.packedBytes - PackedPadding
+                               : header.packedBytes != 0 || newOffsets.back() != header.neighborCount) ||
+       newCreditOffsets.back() != header.creditCount) {
+      return false;
+   }
+
+   //The snapshot is good, so the old graph can go.
+   std::vector<std::vector<std::uint32_t>>().swap(casts);
+   std::vector<std::uint64_t>().swap(creditOffsetStorage);
+   std::vector<std::uint32_t>().swap(creditIdStorage);
+   std::vector<std::uint64_t>().swap(offsetStorage);
+   std::vector<std::uint32_t>().swap(neighborStorage);
+   std::vector<std::uint8_t>().swap(packedStorage);
+   std::vector<std::uint32_t>().swap(nameOrderStorage);
+   std::vector<std::uint32_t>().swap(addedOrderStorage);
+
+   snapshot.Swap(mapping);
+   names.Map(newNameOffsets, newNameBytes, newNameSlots);
+   titles.Map(newTitleOffsets, newTitleBytes, newTitleSlots);
+   nameOrder = newNameOrder;
+   offsets = newOffsets;
+   neighbors = newNeighbors;
+   packed = newPacked;
+   rowEntries = header.neighborCount;
+   creditOffsets = newCreditOffsets;
+   creditIds = newCreditIds;
+   addedOrder = newAddedOrder;
+   frozenPeakBytes = snapshot.Size();
+   frozen = true;
+   return true;
+}
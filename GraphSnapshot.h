@@ -0,0 +1,101 @@
+/*
+File Name:  GraphSnapshot.h
+Author:     Logan Petersen
+Date:       Febuary 2, 2020
+Purpose:    This is the header file describing the binary snapshot a Graph is saved to and mapped
+            back from. A snapshot starts with a SnapshotHeader, followed by these sections, each
+            padded to a multiple of 8 bytes so that every array in the mapping is aligned:
+
+               name offsets     vertexCount + 1 uint64_t
+               name bytes       nameBytes chars
+               name slots       nameSlotCount uint32_t
+               name order       vertexCount uint32_t
+               title offsets    titleCount + 1 uint64_t
+               title bytes      titleBytes chars
+               title slots      titleSlotCount uint32_t
+               row offsets      vertexCount + 1 uint64_t, or titleCount + 1 for a bipartite graph
+               neighbors        neighborCount uint32_t, or none for a compressed graph
+               packed rows      packedBytes bytes, or none unless the graph is compressed
+               credit offsets   vertexCount + 1 uint64_t
+               credits          creditCount uint32_t
+               added order      vertexCount uint32_t, or none for a graph numbered in file order
+
+            The rows are each actor/actress's co-stars, or each movie's cast for a bipartite graph.
+            A graph numbered in another order keeps where each actor/actress was added, so that what
+            is printed keeps the order of the actors list. A compressed graph keeps its rows packed, as
+            PackedRows.h describes, with the row offsets counting bytes of the packed rows, which end
+            with the padding their readers need.
+            Snapshots are written in the byte order of the machine that writes them, and a snapshot
+            of the other byte order is rejected rather than read.
+*/
+
+#pragma once
+
+#include <cstdint> //Grants the fixed width integers the snapshot is made of.
+#include <cstddef> //Grants size_t for sizes of sections.
+
+constexpr char SnapshotMagic[8] = {'K', 'B', 'G', 'S', 'N', 'A', 'P', '\0'}; //The first bytes of every snapshot.
+constexpr std::uint32_t SnapshotVersion = 6;            //Raised whenever the layout changes, so old snapshots are rejected.
+constexpr std::uint32_t SnapshotByteOrder = 0x01020304; //Reads back differently on a machine of the other byte order.
+
+struct SnapshotHeader {
+   char magic[8];                //SnapshotMagic.
+   std::uint32_t version;        //SnapshotVersion when written.
+   std::uint32_t byteOrder;      //SnapshotByteOrder when written.
+   std::uint64_t sourceSize;     //The size of the actors list the snapshot was made from.
+   std::int64_t sourceModified;  //When that actors list was last changed.
+   std::uint64_t vertexCount;    //The number of actors/actresses.
+   std::uint64_t titleCount;     //The number of distinct movies.
+   std::uint64_t neighborCount;  //The number of ids in the rows, which is twice the number of edges.
+   std::uint64_t bipartite;      //1 if the rows are each movie's cast, 0 if they are each actor/actress's co-stars.
+   std::uint64_t compressed;     //1 if the rows are packed, 0 if they are kept in neighbors.
+   std::uint64_t packedBytes;    //The length of the packed rows with their padding, or 0.
+   std::uint64_t creditCount;    //The number of entries in credits.
+   std::uint64_t order;          //The Graph::VertexOrder the vertices are numbered in.
+   std::uint64_t nameBytes;      //The length of all names together.
+   std::uint64_t titleBytes;     //The length of all movies together.
+   std::uint64_t nameSlotCount;  //The number of slots in the name hash table.
+   std::uint64_t titleSlotCount; //The number of slots in the title hash table.
+   std::uint64_t payloadChecksum; //SnapshotChecksum of everything after the header.
+   std::uint64_t headerChecksum;  //SnapshotChecksum of every field above this one.
+};
+
+static_assert(sizeof(SnapshotHeader) % 8 == 0, "The sections after the header must stay 8 byte aligned.");
+
+/*
+Purpose:          Round a section's size up to the padding every section is stored with.
+Parameters:       size, the size of the section in bytes.
+Preconditions:    None.
+Postconditions:   Nothing changes.
+Return value:     size rounded up to a multiple of 8.
+Functions Called: None.
+*/
+inline std::size_t SnapshotPadded(std::size_t size) {
+   return (size + 7) / 8 * 8;
+}
+
+/*
+Purpose:          Fold bytes into a running snapshot checksum, 8 bytes at a time.
+Parameters:       checksum, the checksum so far. Start it at SnapshotChecksumSeed.
+                  data, the bytes to fold in.
+                  size, the number of bytes. The last 8 byte word is padded with zeroes, as sections are on disk.
+Preconditions:    None.
+Postconditions:   Nothing changes.
+Return value:     The checksum with the bytes folded in.
+Functions Called: None.
+*/
+std::uint64_t SnapshotChecksum(std::uint64_t checksum, const void* data, std::size_t size);
+
+constexpr std::uint64_t SnapshotChecksumSeed = 0xcbf29ce484222325; //The value a checksum starts from.
+
+/*
+Purpose:          Find the size and last change time of the actors list a snapshot is made from.
+Parameters:       path, the location of the actors list.
+                  size, set to the size of the file in bytes.
+                  modified, set to when the file was last changed, in the file system's own units.
+Preconditions:    None.
+Postconditions:   Nothing changes.
+Return value:     True if the file exists and both could be found, false otherwise.
+Functions Called: None.
+*/
+bool SnapshotSourceStamp(const char* path, std::uint64_t& size, std::int64_t& modified);
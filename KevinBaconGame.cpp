@@ -36,35 +36,160 @@ Purpose:    The purpose of this code is to read from a file given through argume
             Bacon's node not existing in the file, and attempting to print an empty Graph.
 
             The most imporant algorithm of this program is Graph. Graph stores nodes, named Vertex,
-            which contains movie name and actor, with every person getting only one vertex, meaning
-            that each vertex stores multiple movies. When a vertex is added, for every vertex current
-            in the graph, if the vertex contains a movie also contained in the new vertex, a
-            bidirectional edge is created between the two said vertices. After the program is finished
-            adding vertices to the graph, Kevin Bacon's node is found by iterating through the list of
-            vertices, and a  breadth-first search utilizing a queue is conducted starting from Kevin
+            with every person getting only one vertex, meaning that each vertex has multiple movies.
+            Every name and movie is stored once in a StringArena and known by a 32 bit id, and each
+            vertex is a row of movie ids in one table. Graph also keeps an index from each movie to its
+            cast. When a vertex is added, the casts of its movies are looked up in that index, and a
+            bidirectional edge is created between the new vertex and every co-star found, so adding
+            an actor only costs time proportional to their co-stars. After the program is finished
+            adding vertices to the graph, it is frozen into a compressed sparse row layout, where every
+            vertex has an integer id and all edges sit in one contiguous neighbors array. Kevin
+            Bacon's node is found through the hash table of names, and a breadth-first
+            search utilizing a queue over that layout is conducted starting from Kevin
             Bacons vertex. If Kevin Bacons vertex does not exist, then an error is thrown. As the
             breadth-first search is conducted, every vertex discovered is displayed according to the
             specifications given above.
 
-            Key variables are graph, the Graph object, file, the fstream, strings to read in movies and
-            names, a vector of strings containing movies, a boolean to delimiate what is the name and
-            what is a movie, and a char for the input from file to go to.
+            The file is mapped into memory by MappedFile and read by ActorListParser, which finds
+            tabs and closing brackets with memchr rather than reading one character at a time. The
+            names and movies it returns are string_views into the mapped file, so nothing is copied
+            until Graph stores them. LoadActorList splits the file at blank lines and parses each
+            piece on its own thread, then adds the entries in file order, so the output does not
+            depend on the number of threads. The edges are built on every thread when the graph is
+            frozen.
+
+            The program takes the file followed by optional flags: --threads N sets the number of
+            threads, and --memory reports the memory used by the frozen graph and the resident memory
+            once it is loaded. --snapshot PATH saves the frozen graph to a binary snapshot after
+            reading the file, and on later runs maps the snapshot instead of reading the file, as long
+            as the file has not changed since. Adding --verify-snapshot checksums the whole snapshot
+            before it is used. --center NAME prints
+            distances from NAME instead of from Kevin Bacon. --serve loads the graph once and then
+            answers questions read from cin, and --serve-socket PATH answers them from clients of a
+            local socket instead; QueryServer.h describes the questions. --rank N ranks the N
+            actors/actresses with the most co-stars as centers instead, printing each one's average
+            distance to everyone it reaches, its eccentricity and how many it reaches. Their searches
+            are run together, one bit per actor/actress, so a whole batch costs about one search.
+            --bipartite freezes the graph as actors/actresses and movies instead of co-star edges, so
+            a movie costs one edge per credit rather than one per pair of its cast, and searches step
+            through each movie once. The Bacon Numbers are the same either way. --updates PATH
+            applies the adds and removals listed in PATH to the loaded graph, as LiveGraph.h
+            describes, keeping the Bacon Numbers up to date after each one instead of searching
+            again, and then prints them. Adding --verify-updates checks them against a full search
+            after every update. --stats prints, on cerr once the run is done, a JSON object with the
+            time taken by each phase, the bytes and entries parsed, the duplicate names and movies
+            skipped, the actors/actresses, movies and edges of the graph, each level of the search
+            with its frontier, and the resident memory. Building with NO_RUN_STATS defined leaves
+            the recording out of the program entirely; RunStats.h describes it. --order NAME numbers
+            the actors/actresses so co-stars sit near each other in memory, which speeds up the
+            searches: bfs in the order a search reaches them, degree with the most co-stars first,
+            or rcm for reverse Cuthill-McKee. file, the default, keeps the order of the actors list.
+            The output is the same in every order, and a snapshot keeps the order it was saved in.
+            --compress packs the rows of the frozen graph as the gaps between neighboring ids, in 1
+            to 4 bytes each, and the searches unpack them as they go; PackedRows.h describes the
+            layout. With --order the gaps are small, so the rows take well under half the memory of
+            32 bit ids. Building with -mssse3 or -march=native unpacks four ids at a time.
+            --targets PATH prints the Bacon Numbers of only the actors/actresses named in PATH, one
+            name per line, in the order they are listed. The search stops at the level where the last
+            of them is found, so asking about a handful of actors/actresses costs a small part of
+            printing them all. --serve answers the same question for any center, keeping the searches
+            of recent centers so repeated questions need no search. --sorted prints the Bacon Numbers
+            sorted by number and then by name, each name in the order first name last name, with
+            those who cannot be reached last; SortedOutput.h describes it. Without it each number is
+            printed as soon as the search finds it, with names as they are written in the actors list
+            and each number's actors/actresses in the order they were added. The sorted output is the
+            same for any --threads, --order or --compress, and after --updates.
+
+            The file may be gzip, such as the actors.list.gz IMDB ships, and a file of - reads the
+            actors list from cin, gzip or not. Either is streamed rather than mapped: one thread
+            decompresses and cuts the text into blocks, the others parse them, and the main thread
+            adds them to the graph, each stage handing blocks to the next through a small bounded
+            queue, so the stages overlap and loading takes about as long as the slowest of them.
+            --stats gives each stage's own time as the read, parse and add phases, and the whole as
+            stream. This needs zlib, linked with -lz; building with NO_ZLIB defined leaves it out,
+            and then only text can be streamed.
+
+            Key variables are graph, the Graph object, file, the MappedFile, and the settings read
+            from the flags.
 */
 
 #include "Graph.h"
-#include <fstream> //Grants file reading, for reading in the database.
+#include "MappedFile.h"      //Grants the mapping of the database into memory.
+#include "ActorListLoader.h" //Grants the loader that parses the mapped database on every thread.
+#include "Parallel.h"        //Grants DefaultThreadCount, the number of threads used unless told otherwise.
+#include "GraphSnapshot.h"   //Grants SnapshotSourceStamp, which ties a snapshot to the file it was made from.
+#include "QueryServer.h"     //Grants the server that answers repeated questions about the loaded graph.
+#include "ResidentMemory.h"  //Grants ResidentMemory, for reporting the memory the loaded graph holds.
+#include "LiveGraph.h"       //Grants LiveGraph, which keeps the Bacon Numbers up to date as the graph changes.
+#include "RunStats.h"        //Grants RunStats and PhaseTimer, which --stats records the run with.
+#include <fstream>           //Grants file reading, for reading the updates and the targets and checking for gzip.
+#include <cstdlib>           //Grants atoi, for reading the number of threads.
+
+namespace {
+
+   /*
+   Purpose:          Check whether a file is gzip, by the two bytes every gzip file starts with.
+   Parameters:       path, the location of the file.
+   Preconditions:    None.
+   Postconditions:   Nothing changes.
+   Return value:     True if the file could be opened and starts with those bytes, false otherwise.
+   Functions Called: None.
+   */
+   bool IsGzipFile(const char* path) {
+
+      //Local Variables
+      std::ifstream input(path, std::ios::binary);
+      char magic[2] = {};
+
+      input.read(magic, 2);
+      return input && static_cast<unsigned char>(magic[0]) == 0x1F && static_cast<unsigned char>(magic[1]) == 0x8B;
+   }
+
+   /*
+   Purpose:          Finish a run's RunStats with the size of the graph and the memory held, and print them.
+   Parameters:       graph, the Graph the run loaded.
+                     stats, the RunStats the run recorded, or nullptr if --stats was not given.
+   Preconditions:    None.
+   Postconditions:   The RunStats have been printed to cerr as JSON, if there are any.
+   Return value:     None.
+   Functions Called: ResidentMemory(), which gives the memory held.
+                     RunStats::Write(), which prints them.
+   */
+   void ReportStats(const Graph& graph, RunStats* stats) {
+      if (!RunStatsBuilt || stats == nullptr) {
+         return;
+      }
+      stats->vertices = graph.VertexCount();
+      stats->movies = graph.MovieCount();
+      stats->edges = graph.EdgeCount();
+      ResidentMemory(stats->residentBytes, stats->peakResidentBytes);
+      stats->Write(std::cerr);
+   }
+}
 
 int main(int argc, char** argv) {
 
    //Local Variables
    Graph graph;
-   std::fstream file;               //Will be used to read file.
-   std::string name;                //Name of actor/actress being added to Graph.
-   std::string movie;               //Name of movie that will be added to the movies vector to be added to Graph.
-   std::vector<std::string> movies; //Movies a specific actor/actress has been involved in.
-   char input;                      //Used to read from cin.
-   bool readingName = true;         //Used to parse input from the file. Starts at true because database starts at name.
-                                    //Furthermore, after this is false, we are reading movies until a blank line.
+   MappedFile file;                           //Will be used to read file.
+   bool reportMemory = false;                 //Set by --memory, to report the memory used by the frozen graph.
+   unsigned threadCount = DefaultThreadCount(); //Set by --threads, the number of threads used to load the file.
+   const char* snapshotPath = nullptr;        //Set by --snapshot, where the graph is saved to and loaded from.
+   bool verifySnapshot = false;               //Set by --verify-snapshot, to checksum all of a snapshot before using it.
+   std::uint64_t sourceSize = 0;              //The size of the file, which a snapshot must match.
+   std::int64_t sourceModified = 0;           //When the file was last changed, which a snapshot must match.
+   bool fromInput;                            //True when the actors list is read from cin, given as -.
+   bool stamped;                              //True when the file's size and change time were found.
+   bool loaded;                               //True when the graph was mapped from a snapshot.
+   bool serve = false;                        //Set by --serve, to answer questions from cin instead of printing.
+   const char* socketPath = nullptr;          //Set by --serve-socket, to answer questions from a local socket instead.
+   std::size_t loadedResident = 0;            //The resident memory once the graph is loaded.
+   std::size_t loadedPeak = 0;                //The most resident memory while loading it.
+   std::size_t rankCount = 0;                 //Set by --rank, the number of centers to rank instead of printing.
+   const char* updatesPath = nullptr;         //Set by --updates, the changes to apply before printing.
+   const char* targetsPath = nullptr;         //Set by --targets, the actors/actresses to print instead of everyone.
+   bool verifyUpdates = false;                //Set by --verify-updates, to check every update against a full search.
+   RunStats stats;                            //What --stats records about the run.
 
    //If no argument was given.
    if (argv[1] == nullptr) {
@@ -72,102 +197,266 @@ int main(int argc, char** argv) {
       return 0;
    }
 
-   //Open the file for read.
-   file.open(argv[1]);
+   //Options follow the file name.
+   for (int i = 2; i < argc; i++) {
+      //Every option has not been read yet.
 
-   //If file is open, returns an error if file did not open sucessfully.
-   if (file) {
-      while (file.get(input)) {
-         //The character stream has not ended.
+      std::string option = argv[i];
+      if (option == "--memory") {
+         reportMemory = true;
+      }
+      else if (option == "--threads" && i + 1 < argc) {
+         threadCount = static_cast<unsigned>(std::max(1, std::atoi(argv[++i])));
+      }
+      else if (option == "--snapshot" && i + 1 < argc) {
+         snapshotPath = argv[++i];
+      }
+      else if (option == "--verify-snapshot") {
+         verifySnapshot = true;
+      }
+      else if (option == "--center" && i + 1 < argc) {
+         graph.SetCenter(argv[++i]);
+      }
+      else if (option == "--serve") {
+         serve = true;
+      }
+      else if (option == "--serve-socket" && i + 1 < argc) {
+         socketPath = argv[++i];
+      }
+      else if (option == "--bipartite") {
+         graph.SetBipartite(true);
+      }
+      else if (option == "--compress") {
+         graph.SetCompressed(true);
+      }
+      else if (option == "--sorted") {
+         graph.SetSortedOutput(true);
+      }
+      else if (option == "--updates" && i + 1 < argc) {
+         updatesPath = argv[++i];
+      }
+      else if (option == "--targets" && i + 1 < argc) {
+         targetsPath = argv[++i];
+      }
+      else if (option == "--verify-updates") {
+         verifyUpdates = true;
+      }
+      else if (option == "--order" && i + 1 < argc) {
+         Graph::VertexOrder order;
+
+         if (!Graph::OrderFromName(argv[++i], order)) {
+            std::cout << "Unknown order " << argv[i] << ". The orders are file, bfs, degree and rcm.\n";
+            return 0;
+         }
+         graph.SetOrder(order);
+      }
+      else if (option == "--stats") {
+         if (!RunStatsBuilt) {
+            std::cerr << "This program was built without --stats.\n";
+         }
+         graph.SetStats(&stats);
+      }
+      else if (option == "--rank" && i + 1 < argc) {
+         rankCount = static_cast<std::size_t>(std::max(1, std::atoi(argv[++i])));
+      }
+      else {
+         std::cout << "Unknown option " << option << ".\n";
+         return 0;
+      }
+   }
+   graph.SetThreadCount(threadCount);
+
+   //Standard input has no size or change time to tie a snapshot to, so it is never saved or loaded.
+   fromInput = std::string(argv[1]) == "-";
+   stamped = !fromInput && SnapshotSourceStamp(argv[1], sourceSize, sourceModified);
+   if (snapshotPath != nullptr && fromInput) {
+      std::cerr << "--snapshot is ignored when the actors list is read from cin.\n";
+   }
+
+   //A snapshot made from this exact file is mapped in place of reading the file.
+   loaded = snapshotPath != nullptr && stamped && graph.LoadSnapshot(snapshotPath, sourceSize, sourceModified, verifySnapshot);
 
-         //This occurs after name field has been read.
-         if (input == '\t') {
-            readingName = false;
+   if (!loaded) {
+      //Standard input and gzip files are streamed through the pipelined loader, since neither can be mapped as text.
+      if (fromInput || IsGzipFile(argv[1])) {
+         bool complete = StreamActorList(graph, argv[1], threadCount);
+
+         if (!complete) {
+            std::cout << "The file could not be read to its end.\n";
          }
 
-         //Add character to name.
-         if (readingName == true) {
-            name.push_back(input);
+         //Save the graph so the next run can map it instead, unless it holds only part of the file.
+         if (snapshotPath != nullptr && complete && stamped && !graph.SaveSnapshot(snapshotPath, sourceSize, sourceModified)) {
+            std::cerr << "The snapshot could not be written to " << snapshotPath << ".\n";
          }
+      }
 
-         if (readingName == false) {
+      //Open the file for read, returns an error if file did not open sucessfully.
+      else if (file.Open(argv[1])) {
+         LoadActorList(graph, file.Data(), file.Data() + file.Size(), threadCount);
 
-            //This covers the case of ()s.
-            if (input == '(' && !std::isdigit(file.peek())) {
-               while (file.get(input)) {
-                  //The character stream has not ended and has not been broken.
+         //Save the graph so the next run can map it instead.
+         if (snapshotPath != nullptr && stamped && !graph.SaveSnapshot(snapshotPath, sourceSize, sourceModified)) {
+            std::cerr << "The snapshot could not be written to " << snapshotPath << ".\n";
+         }
+      }
 
-                  if (input == ')') {
-                     file.get(input);
-                     break;
-                  }
-               }
-            }
+      else {
+         std::cout << "The file could not be opened.\nPerhaps path is wrong or name does not exist?\n";
+      }
+   }
 
-            //This covers the case of {}.
-            if (input == '{') {
-               while (file.get(input)) {
-                  //The character stream has not ended and has not been broken..
+   //Measured before anything is printed, so this is the memory of the graph and the mapped file alone.
+   graph.Finalize();
+   ResidentMemory(loadedResident, loadedPeak);
 
-                  if (input == '}') {
-                     file.get(input);
-                     break;
-                  }
-               }
-            }
+   //Answer questions about the graph for as long as they come, loading it only the once.
+   if (serve || socketPath != nullptr) {
+      QueryServer server(graph, threadCount);
 
-            //This covers the case of <> and [].
-            if (input == '<' || input == '[') {
-               while (file.get(input)) {
-                  //The character stream has not ended and has not been broken..
+      if (socketPath != nullptr && !server.ServeSocket(socketPath)) {
+         std::cout << "The socket " << socketPath << " could not be created.\n";
+      }
+      else if (socketPath == nullptr) {
+         server.Serve(std::cin, std::cout);
+      }
+      ReportStats(graph, graph.Stats());
+      return 0;
+   }
 
-                  if (input == '>' || input == ']') {
-                     file.get(input);
-                     break;
-                  }
-               }
-            }
+   //Rank the centers in place of printing the Bacon Numbers.
+   if (rankCount != 0) {
+      {
+         PhaseTimer timer(graph.Stats(), "rank");
+         OutputWriter writer(std::cout);
 
-            //This covers the case of spaces, and if not space then it is actually a movie.
-            //!std::isspace(input)
-            if (input != '\n' && input != '\t' && input != ' ') {
-               movie.push_back(input);
-            }
+         graph.RankCenters(rankCount, threadCount, writer);
+      }
+      ReportStats(graph, graph.Stats());
+      return 0;
+   }
 
-            //End of line for actor/actress.
-            if (file.peek() == EOF || input == '\n' && !movie.empty() && file.peek() == '\t' || file.peek() == '\n') {
+   //Print only the actors/actresses asked about, searching no farther than the farthest of them.
+   if (targetsPath != nullptr) {
+      std::ifstream targetFile(targetsPath);
+      std::string line;
+      std::vector<std::uint32_t> targets;
+      std::vector<int> distances;
+      Graph::SearchScratch scratch;
+      std::uint32_t center = graph.Find(graph.CenterName());
 
-               //If movie already exists, no need to duplicate it.
-               if (std::find(movies.begin(), movies.end(), movie) == movies.end()) {
-                  movies.push_back(movie);
-               }
-               movie.erase();
-            }
+      if (!targetFile) {
+         std::cout << "The targets could not be opened.\n";
+         return 0;
+      }
+      if (center == Graph::NoVertex) {
+         std::cout << graph.CenterName() << " not in Graph.\n";
+         return 0;
+      }
+      while (std::getline(targetFile, line)) {
+         //Every name listed has not been found yet.
+
+         if (!line.empty() && line.back() == '\r') {
+            line.pop_back();
+         }
+         if (line.empty()) {
+            continue;
+         }
+         targets.push_back(graph.Find(line));
+         if (targets.back() == Graph::NoVertex) {
+            std::cerr << line << " is not in the file.\n";
+            targets.pop_back();
+         }
+      }
+      {
+         PhaseTimer timer(graph.Stats(), "targets");
 
-            //End of actor/actress entry.
-            if (file.peek() == EOF || input == '\n' && file.peek() == '\n') {
-               graph.Add(name, movies);
-               name.erase();
-               movies.clear();
-               movie.erase();
-               readingName = true;
+         scratch.stats = graph.Stats();
+         graph.DistancesTo(center, targets, scratch, threadCount, distances);
+      }
+      {
+         PhaseTimer timer(graph.Stats(), "print");
+         OutputWriter writer(std::cout);
 
-               //Put reader on the next name.
-               while (!file.eof() && !std::isalpha(file.peek())) {
-                  //File has not ended and the next character is not a letter of the alphabet.
+         for (std::size_t i = 0; i < targets.size(); i++) {
+            //Every actor/actress listed has not been printed yet.
 
-                  file.get();
-               }
+            writer.Write(graph.NameOf(targets[i]));
+            writer.Write('\t');
+            if (distances[i] == -1) {
+               writer.Write("infinity");
             }
+            else {
+               writer.WriteNumber(distances[i]);
+            }
+            writer.Write('\n');
          }
       }
+      ReportStats(graph, graph.Stats());
+      return 0;
    }
 
-   else {
-      std::cout << "The file could not be opened.\nPerhaps path is wrong or name does not exist?\n";
+   //Apply the updates one at a time, repairing only the distances each one changes, then print the result.
+   if (updatesPath != nullptr) {
+      LiveGraph live(graph);
+      std::ifstream updates(updatesPath);
+      std::string line;
+      std::size_t lineNumber = 0;
+      std::size_t applied = 0;
+      std::size_t repaired = 0;   //The actors/actresses and movies the updates touched in all.
+
+      if (!updates) {
+         std::cout << "The updates could not be opened.\n";
+         return 0;
+      }
+      {
+         PhaseTimer timer(graph.Stats(), "updates");
+
+         while (std::getline(updates, line)) {
+            //Every update has not been applied yet.
+
+            lineNumber++;
+            if (line.empty()) {
+               continue;
+            }
+            if (!live.Apply(line)) {
+               std::cerr << "Line " << lineNumber << " of the updates is not an update.\n";
+               continue;
+            }
+            applied++;
+            repaired += live.LastRepairCount();
+            if (verifyUpdates && !live.Verify()) {
+               std::cerr << "Line " << lineNumber << " of the updates left distances a full search disagrees with.\n";
+            }
+         }
+      }
+      if (verifyUpdates) {
+         std::cerr << "Checked " << applied << " updates against a full search, touching " << repaired << " actors/actresses and movies.\n";
+      }
+
+      {
+         PhaseTimer timer(graph.Stats(), "print");
+         OutputWriter writer(std::cout);
+
+         live.Write(writer);
+      }
+      ReportStats(graph, graph.Stats());
+      return 0;
    }
 
    //Print the Bacon Numbers for all actors found.
-   std::cout << graph;
+   {
+      PhaseTimer timer(graph.Stats(), "print");
+
+      std::cout << graph;
+   }
+
+   //Report the memory used by the frozen graph when asked to, on cerr so the Bacon Numbers are left untouched.
+   if (reportMemory) {
+      std::cerr << "Frozen graph: " << graph.EdgeCount() << " edges in " << graph.RowBytes() << " bytes, peak of "
+                << graph.FrozenPeakBytes() << " bytes.\n";
+      std::cerr << "Resident memory: " << loadedResident << " bytes once loaded, peak of " << loadedPeak << " bytes.\n";
+   }
+   ReportStats(graph, graph.Stats());
    return 0;
 }
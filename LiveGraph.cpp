@@ -0,0 +1,668 @@
+/*
+File Name:  LiveGraph.cpp
+Author:     Logan Petersen
+Date:       Febuary 2, 2020
+Purpose:    The purpose of this code is to be the function definitions for
+            the prototypes in LiveGraph.h. A removal first finds every node
+            that lost its only way to the center, nearest first, and only those
+            are given distances again.
+*/
+
+#include "LiveGraph.h"
+#include "SortedOutput.h" //Grants WriteSorted, which prints the distances sorted.
+#include "ActorListParser.h" //Grants ActorListParser, which cleans movies written in an update.
+#include <queue>      //Grants priority_queue, which gives repaired nodes their distances nearest first.
+#include <functional> //Grants greater, which makes the priority_queue give the smallest distance first.
+#include <utility>    //Grants pair, a distance and the node it is for.
+#include <string>     //Grants string, which holds a movie while the parser cleans it.
+
+/*
+Purpose:          Construct the LiveGraph for a Graph, measuring every distance from the Graph's center.
+Parameters:       graph, the Graph to start from. It must be frozen and must outlive the LiveGraph.
+Preconditions:    This specific LiveGraph object has not been instantiated.
+Postconditions:   LiveGraph object has been instantiated with a copy of the Graph's credits and the distance of
+                  every actor/actress and movie from the center, if the center is in the Graph.
+Return value:     None.
+Functions Called: Graph::ComputeDistances(), which gives the first distances.
+*/
+LiveGraph::LiveGraph(const Graph& graph) : graph(graph) {
+
+   //Local Variables
+   Graph::SearchScratch scratch;
+
+   center = graph.Find(graph.CenterName());
+   baseActors = graph.VertexCount();
+   baseMovies = graph.MovieCount();
+   stamp = 0;
+   repairCount = 0;
+   credits.resize(baseActors);
+   casts.resize(baseMovies);
+   removed.assign(baseActors, false);
+   actorSteps.assign(baseActors, Unreached);
+   movieSteps.assign(baseMovies, Unreached);
+   actorMark.assign(baseActors, 0);
+   movieMark.assign(baseMovies, 0);
+   for (std::uint32_t id = 0; id < baseActors; id++) {
+      //Every Vertex of the Graph has not had its credits copied yet.
+
+      for (std::uint32_t movie : graph.CreditsOf(id)) {
+         //Every movie of this Vertex has not been copied yet.
+
+         credits[id].push_back(movie | MovieNode);
+         casts[movie].push_back(id);
+      }
+   }
+
+   if (center == Graph::NoVertex) {
+      return;
+   }
+   graph.ComputeDistances(center, scratch, graph.ThreadCount(), nullptr);
+   for (std::uint32_t id = 0; id < baseActors; id++) {
+      //Every Vertex has not been given its distance yet.
+
+      if (scratch.distances[id] == -1) {
+         continue;
+      }
+      actorSteps[id] = 2 * static_cast<std::uint32_t>(scratch.distances[id]);
+
+      //A movie is one step past the nearest of its cast.
+      for (std::uint32_t movie : credits[id]) {
+         //Every movie of this Vertex has not been given a distance through it yet.
+
+         movieSteps[movie & ~MovieNode] = std::min(movieSteps[movie & ~MovieNode], actorSteps[id] + 1);
+      }
+   }
+}
+
+/*
+Purpose:          Give an actor/actress a credit for a movie, adding either if they are new.
+Parameters:       name, the actor/actress's name as written in the actors list.
+                  movie, the movie's name as the parser leaves it.
+Preconditions:    A LiveGraph object has been instantiated.
+Postconditions:   The credit is in the LiveGraph, and every distance it shortened has been lowered.
+Return value:     True if the credit is new, false if the actor/actress already had it.
+Functions Called: Lower(), which lowers the distances the credit shortens.
+*/
+bool LiveGraph::AddCredit(std::string_view name, std::string_view movie) {
+
+   //Local Variables
+   std::uint32_t id;
+   std::uint32_t movieId = FindMovie(movie);
+   std::uint32_t node;
+   bool added;
+
+   AddActor(name);
+   id = FindActor(name);
+   repairCount = 0;
+
+   //A movie new to the Graph starts with an empty cast.
+   if (movieId == Graph::NoVertex) {
+      movieId = static_cast<std::uint32_t>(baseMovies + addedMovies.Intern(movie, added));
+      casts.emplace_back();
+      movieSteps.push_back(Unreached);
+      movieMark.push_back(0);
+   }
+   node = movieId | MovieNode;
+   if (std::find(credits[id].begin(), credits[id].end(), node) != credits[id].end()) {
+      return false;
+   }
+   credits[id].push_back(node);
+   casts[movieId].push_back(id);
+
+   //Whichever end is nearer the center may now bring the other nearer.
+   Lower(id, node);
+   Lower(node, id);
+   return true;
+}
+
+/*
+Purpose:          Add an actor/actress with no credits.
+Parameters:       name, the actor/actress's name as written in the actors list.
+Preconditions:    A LiveGraph object has been instantiated.
+Postconditions:   The actor/actress is in the LiveGraph. They cannot be reached until they are given a credit.
+Return value:     True if the actor/actress is new, false if they were already in the LiveGraph.
+Functions Called: None.
+*/
+bool LiveGraph::AddActor(std::string_view name) {
+
+   //Local Variables
+   std::uint32_t id = FindActor(name);
+   bool added;
+
+   repairCount = 0;
+   if (id != Graph::NoVertex) {
+      if (!removed[id]) {
+         return false;
+      }
+      removed[id] = false;
+      return true;
+   }
+
+   id = static_cast<std::uint32_t>(baseActors + addedNames.Intern(name, added));
+   credits.emplace_back();
+   removed.push_back(false);
+   actorSteps.push_back(Unreached);
+   actorMark.push_back(0);
+
+   //A center that was missing from the Graph is measured from as soon as it is added.
+   if (center == Graph::NoVertex && name == graph.CenterName()) {
+      center = id;
+      actorSteps[id] = 0;
+   }
+   return true;
+}
+
+/*
+Purpose:          Take away an actor/actress's credit for a movie.
+Parameters:       name, the actor/actress's name as written in the actors list.
+                  movie, the movie's name as the parser leaves it.
+Preconditions:    A LiveGraph object has been instantiated.
+Postconditions:   The credit is gone, and every distance that depended on it has been repaired.
+Return value:     True if the credit was taken away, false if there was no such credit.
+Functions Called: Repair(), which repairs the distances that depended on the credit.
+*/
+bool LiveGraph::RemoveCredit(std::string_view name, std::string_view movie) {
+
+   //Local Variables
+   std::uint32_t id = FindActor(name);
+   std::uint32_t movieId = FindMovie(movie);
+   std::vector<std::uint32_t>::iterator credit;
+
+   repairCount = 0;
+   if (id == Graph::NoVertex || movieId == Graph::NoVertex) {
+      return false;
+   }
+   credit = std::find(credits[id].begin(), credits[id].end(), movieId | MovieNode);
+   if (credit == credits[id].end()) {
+      return false;
+   }
+   credits[id].erase(credit);
+   casts[movieId].erase(std::find(casts[movieId].begin(), casts[movieId].end(), id));
+   Repair(id, movieId | MovieNode);
+   return true;
+}
+
+/*
+Purpose:          Remove an actor/actress and all of their credits.
+Parameters:       name, the actor/actress's name as written in the actors list.
+Preconditions:    A LiveGraph object has been instantiated.
+Postconditions:   The actor/actress is no longer listed, and every distance that depended on their credits has been
+                  repaired. Adding them again brings them back with no credits.
+Return value:     True if the actor/actress was removed, false if they were not in the LiveGraph.
+Functions Called: Repair(), once for each credit.
+*/
+bool LiveGraph::RemoveActor(std::string_view name) {
+
+   //Local Variables
+   std::uint32_t id = FindActor(name);
+   std::size_t repaired = 0; //The nodes touched by every credit's repair together.
+
+   repairCount = 0;
+   if (id == Graph::NoVertex || removed[id]) {
+      return false;
+   }
+   while (!credits[id].empty()) {
+      //The actor/actress has credits left to take away.
+
+      std::uint32_t node = credits[id].back();
+      std::vector<std::uint32_t>& cast = casts[node & ~MovieNode];
+
+      credits[id].pop_back();
+      cast.erase(std::find(cast.begin(), cast.end(), id));
+      Repair(id, node);
+      repaired += repairCount;
+   }
+   removed[id] = true;
+   repairCount = repaired;
+   return true;
+}
+
+/*
+Purpose:          Apply one update written as described in LiveGraph.h.
+Parameters:       line, the update.
+Preconditions:    A LiveGraph object has been instantiated.
+Postconditions:   The update has been applied if it is well formed.
+Return value:     False if the line is not an update, true otherwise, even if the update changed nothing.
+Functions Called: ActorListParser::Next(), which cleans the movie as the actors list's movies are cleaned,
+                  AddCredit(), AddActor(), RemoveCredit() and RemoveActor().
+*/
+bool LiveGraph::Apply(std::string_view line) {
+
+   //Local Variables
+   std::vector<std::string_view> parts;
+   std::size_t tab;
+   std::string entry; //The movie written as a one credit entry, for the parser to clean in place.
+   std::string_view name;
+   std::vector<std::string_view> movies;
+
+   if (!line.empty() && line.back() == '\r') {
+      line.remove_suffix(1);
+   }
+   while ((tab = line.find('\t')) != std::string_view::npos) {
+      //Another tab ends the next part.
+
+      parts.push_back(line.substr(0, tab));
+      line.remove_prefix(tab + 1);
+   }
+   parts.push_back(line);
+
+   if (parts.size() < 2 || parts.size() > 3 || parts[1].empty() || (parts[0] != "+" && parts[0] != "-")) {
+      return false;
+   }
+
+   //The Graph keeps movies as the parser leaves them, so the movie is cleaned the same way before it is looked up.
+   if (parts.size() == 3) {
+      entry = "-\t";
+      entry.append(parts[2]);
+      entry += '\n';
+      if (!ActorListParser(entry.data(), entry.data() + entry.size()).Next(name, movies) || movies.empty() || movies[0].empty()) {
+         return false;
+      }
+      parts[2] = movies[0];
+   }
+   if (parts[0] == "+" && parts.size() == 3) {
+      AddCredit(parts[1], parts[2]);
+   }
+   else if (parts[0] == "+") {
+      AddActor(parts[1]);
+   }
+   else if (parts.size() == 3) {
+      RemoveCredit(parts[1], parts[2]);
+   }
+   else {
+      RemoveActor(parts[1]);
+   }
+   return true;
+}
+
+/*
+Purpose:          Print every actor/actress and their distance from the center on seperate lines, in the same
+                  order and format as Graph::GenerateNumbers, or as Graph::GenerateSortedNumbers if the Graph was
+                  given SetSortedOutput.
+Parameters:       out, the writer the lines are printed through.
+Preconditions:    A LiveGraph object has been instantiated.
+Postconditions:   Every line has been given to out.
+Return value:     None.
+Functions Called: Graph::AddedPosition(), which keeps the Graph's actors/actresses in the order they were added, and
+                  WriteSorted(), which sorts the lines instead.
+*/
+void LiveGraph::Write(OutputWriter& out) const {
+
+   //Local Variables
+   std::vector<std::vector<std::uint32_t>> levels; //The ids at each distance, in the order they were added.
+   std::vector<std::uint32_t> byAdded(credits.size()); //Every id, in the order they were added.
+
+   //The same answers operator<< gives when there is nobody to measure from.
+   if (credits.empty()) {
+      out.Write("No actor/actresses in this Graph.\n");
+      return;
+   }
+   if (center == Graph::NoVertex || removed[center]) {
+      out.Write(graph.CenterName() == "Bacon, Kevin (I)" ? std::string_view("Kevin Bacon") : std::string_view(graph.CenterName()));
+      out.Write(" not in Graph.\n");
+      return;
+   }
+
+   //Sorted output only needs every actor/actress still in the graph and their distance.
+   if (graph.SortedOutput()) {
+      std::vector<std::uint32_t> ids;
+      std::vector<int> distances(credits.size(), -1);
+
+      for (std::uint32_t id = 0; id < credits.size(); id++) {
+         //Every actor/actress has not been listed yet.
+
+         if (!removed[id]) {
+            ids.push_back(id);
+            if (actorSteps[id] != Unreached) {
+               distances[id] = static_cast<int>(actorSteps[id] / 2);
+            }
+         }
+      }
+      WriteSorted(ids, distances, [this](std::uint32_t id) { return NameOf(id); }, graph.ThreadCount(), out);
+      return;
+   }
+
+   //The Graph may have numbered its own vertices in another order, while those added since follow them in order.
+   for (std::uint32_t id = 0; id < credits.size(); id++) {
+      //Every actor/actress has not been placed in the order they were added yet.
+
+      byAdded[id < baseActors ? graph.AddedPosition(id) : id] = id;
+   }
+
+   for (std::uint32_t id : byAdded) {
+      //Every actor/actress has not been put into their level yet.
+
+      if (removed[id] || actorSteps[id] == Unreached) {
+         continue;
+      }
+      if (levels.size() <= actorSteps[id] / 2) {
+         levels.resize(actorSteps[id] / 2 + 1);
+      }
+      levels[actorSteps[id] / 2].push_back(id);
+   }
+   for (std::size_t distance = 0; distance < levels.size(); distance++) {
+      //Every level has not been printed yet.
+
+      for (std::uint32_t id : levels[distance]) {
+         //Every actor/actress at this distance has not been printed yet.
+
+         out.Write(NameOf(id));
+         out.Write('\t');
+         out.WriteNumber(static_cast<long long>(distance));
+         out.Write('\n');
+      }
+   }
+
+   //For the actors/actresses that are not connected to the center.
+   for (std::uint32_t id : byAdded) {
+      //Every actor/actress has not been checked yet.
+
+      if (!removed[id] && actorSteps[id] == Unreached) {
+         out.Write(NameOf(id));
+         out.Write("\tinfinity\n");
+      }
+   }
+}
+
+/*
+Purpose:          Check every distance against a full breadth first search of the LiveGraph from the center.
+Parameters:       None.
+Preconditions:    A LiveGraph object has been instantiated.
+Postconditions:   Nothing in the LiveGraph changes.
+Return value:     True if every actor/actress and movie has the distance the full search gives it.
+Functions Called: None.
+*/
+bool LiveGraph::Verify() const {
+
+   //Local Variables
+   std::vector<std::uint32_t> expectedActors(actorSteps.size(), Unreached);
+   std::vector<std::uint32_t> expectedMovies(movieSteps.size(), Unreached);
+   std::vector<std::uint32_t> queue;
+
+   auto expected = [&expectedActors, &expectedMovies](std::uint32_t node) -> std::uint32_t& {
+      return (node & MovieNode) ? expectedMovies[node & ~MovieNode] : expectedActors[node];
+   };
+
+   if (center != Graph::NoVertex) {
+      expectedActors[center] = 0;
+      queue.push_back(center);
+   }
+   for (std::size_t i = 0; i < queue.size(); i++) {
+      //Every node reached has not been expanded yet.
+
+      for (std::uint32_t neighbor : Neighbors(queue[i])) {
+         //Every neighbor of this node has not been checked yet.
+
+         if (expected(neighbor) == Unreached) {
+            expected(neighbor) = expected(queue[i]) + 1;
+            queue.push_back(neighbor);
+         }
+      }
+   }
+   return expectedActors == actorSteps && expectedMovies == movieSteps;
+}
+
+/*
+Purpose:          Report how much the last update touched.
+Parameters:       None.
+Preconditions:    A LiveGraph object has been instantiated.
+Postconditions:   Nothing in the LiveGraph changes.
+Return value:     The number of actors/actresses and movies whose distance the last update changed or searched again.
+Functions Called: None.
+*/
+std::size_t LiveGraph::LastRepairCount() const {
+   return repairCount;
+}
+
+/*
+Purpose:          Find an actor/actress's id, in the Graph or among those added since.
+Parameters:       name, the actor/actress's name as written in the actors list.
+Preconditions:    A LiveGraph object has been instantiated.
+Postconditions:   Nothing in the LiveGraph changes.
+Return value:     The id, or Graph::NoVertex if the name is in neither. A removed actor/actress still has an id.
+Functions Called: Graph::Find() and StringArena::Find().
+*/
+std::uint32_t LiveGraph::FindActor(std::string_view name) const {
+
+   //Local Variables
+   std::uint32_t id = graph.Find(name);
+
+   if (id != Graph::NoVertex) {
+      return id;
+   }
+   id = addedNames.Find(name);
+   return id == StringArena::NoString ? Graph::NoVertex : static_cast<std::uint32_t>(baseActors + id);
+}
+
+/*
+Purpose:          Find a movie's id, in the Graph or among those added since.
+Parameters:       movie, the movie's name as the parser leaves it.
+Preconditions:    A LiveGraph object has been instantiated.
+Postconditions:   Nothing in the LiveGraph changes.
+Return value:     The id, or Graph::NoVertex if the movie is in neither.
+Functions Called: Graph::FindMovie() and StringArena::Find().
+*/
+std::uint32_t LiveGraph::FindMovie(std::string_view movie) const {
+
+   //Local Variables
+   std::uint32_t id = graph.FindMovie(movie);
+
+   if (id != Graph::NoVertex) {
+      return id;
+   }
+   id = addedMovies.Find(movie);
+   return id == StringArena::NoString ? Graph::NoVertex : static_cast<std::uint32_t>(baseMovies + id);
+}
+
+/*
+Purpose:          Give the name of an actor/actress, from the Graph or from those added since.
+Parameters:       id, the actor/actress's id.
+Preconditions:    id is in the LiveGraph.
+Postconditions:   Nothing in the LiveGraph changes.
+Return value:     The name.
+Functions Called: Graph::NameOf() and StringArena::Get().
+*/
+std::string_view LiveGraph::NameOf(std::uint32_t id) const {
+   return id < baseActors ? graph.NameOf(id) : addedNames.Get(static_cast<std::uint32_t>(id - baseActors));
+}
+
+/*
+Purpose:          Give the distance of a node.
+Parameters:       node, an actor/actress's id, or a movie's id with MovieNode set.
+Preconditions:    node is in the LiveGraph.
+Postconditions:   Nothing in the LiveGraph changes.
+Return value:     A reference to the node's distance in steps, or Unreached.
+Functions Called: None.
+*/
+std::uint32_t& LiveGraph::Steps(std::uint32_t node) {
+   return (node & MovieNode) ? movieSteps[node & ~MovieNode] : actorSteps[node];
+}
+
+std::uint32_t LiveGraph::Steps(std::uint32_t node) const {
+   return (node & MovieNode) ? movieSteps[node & ~MovieNode] : actorSteps[node];
+}
+
+/*
+Purpose:          Give the neighbors of a node.
+Parameters:       node, an actor/actress's id, or a movie's id with MovieNode set.
+Preconditions:    node is in the LiveGraph.
+Postconditions:   Nothing in the LiveGraph changes.
+Return value:     An actor/actress's movies with MovieNode set, or a movie's cast.
+Functions Called: None.
+*/
+const std::vector<std::uint32_t>& LiveGraph::Neighbors(std::uint32_t node) const {
+   return (node & MovieNode) ? casts[node & ~MovieNode] : credits[node];
+}
+
+/*
+Purpose:          Lower the distances a new link between two nodes shortens, moving outward from the link.
+Parameters:       from and to, the two nodes, where to is the one that may now be nearer.
+Preconditions:    The link is in the LiveGraph, and every distance was right before it was added.
+Postconditions:   Every distance is right.
+Return value:     None.
+Functions Called: Steps() and Neighbors().
+*/
+void LiveGraph::Lower(std::uint32_t from, std::uint32_t to) {
+
+   //Local Variables
+   std::vector<std::uint32_t> queue; //The nodes lowered, in the order of their new distances.
+
+   if (Steps(from) == Unreached || Steps(from) + 1 >= Steps(to)) {
+      return;
+   }
+   Steps(to) = Steps(from) + 1;
+   queue.push_back(to);
+   for (std::size_t i = 0; i < queue.size(); i++) {
+      //Every lowered node has not passed its distance on yet.
+
+      for (std::uint32_t neighbor : Neighbors(queue[i])) {
+         //Every neighbor of this node has not been checked yet.
+
+         if (Steps(queue[i]) + 1 < Steps(neighbor)) {
+            Steps(neighbor) = Steps(queue[i]) + 1;
+            queue.push_back(neighbor);
+         }
+      }
+   }
+   repairCount += queue.size();
+}
+
+/*
+Purpose:          Repair the distances that depended on a link between two nodes that has been taken away.
+Parameters:       first and second, the two nodes.
+Preconditions:    The link is no longer in the LiveGraph, and every distance was right before it was taken away.
+Postconditions:   Every distance is right.
+Return value:     None.
+Functions Called: HasParent(), Steps() and Neighbors().
+*/
+void LiveGraph::Repair(std::uint32_t first, std::uint32_t second) {
+
+   //Local Variables
+   std::uint32_t far;                 //The end of the link that may have reached the center through it.
+   std::vector<std::uint32_t> lost;   //The nodes left with no neighbor one step nearer, nearest first.
+   std::priority_queue<std::pair<std::uint32_t, std::uint32_t>, std::vector<std::pair<std::uint32_t, std::uint32_t>>,
+                       std::greater<std::pair<std::uint32_t, std::uint32_t>>> nearest; //Distances offered to lost nodes.
+
+   //Only a link between neighboring levels can have been on a shortest path.
+   if (Steps(first) != Unreached && Steps(first) + 1 == Steps(second)) {
+      far = second;
+   }
+   else if (Steps(second) != Unreached && Steps(second) + 1 == Steps(first)) {
+      far = first;
+   }
+   else {
+      return;
+   }
+
+   //The marks only need clearing when stamp wraps around.
+   if (stamp == 0xFFFFFFFF) {
+      std::fill(actorMark.begin(), actorMark.end(), 0);
+      std::fill(movieMark.begin(), movieMark.end(), 0);
+      stamp = 0;
+   }
+   stamp++;
+   if (HasParent(far)) {
+      return;
+   }
+
+   //A node is lost once every neighbor one step nearer is lost. Those are all found before the node is checked,
+   //since the lost nodes are found a level at a time.
+   auto mark = [this, &lost](std::uint32_t node) {
+      ((node & MovieNode) ? movieMark[node & ~MovieNode] : actorMark[node]) = stamp;
+      lost.push_back(node);
+   };
+   mark(far);
+   for (std::size_t i = 0; i < lost.size(); i++) {
+      //Every lost node has not had the neighbors after it checked yet.
+
+      for (std::uint32_t neighbor : Neighbors(lost[i])) {
+         //Every neighbor of this lost node has not been checked yet.
+
+         if (Steps(neighbor) == Steps(lost[i]) + 1 && !Marked(neighbor) && !HasParent(neighbor)) {
+            mark(neighbor);
+         }
+      }
+   }
+
+   for (std::uint32_t node : lost) {
+      //Every lost node has not lost its distance yet.
+
+      Steps(node) = Unreached;
+   }
+
+   //Each lost node is offered one step past its nearest neighbor that kept a distance.
+   for (std::uint32_t node : lost) {
+      //Every lost node has not been offered a distance yet.
+
+      std::uint32_t best = Unreached;
+      for (std::uint32_t neighbor : Neighbors(node)) {
+         //Every neighbor of this lost node has not been checked yet.
+
+         if (Steps(neighbor) != Unreached && Steps(neighbor) + 1 < best) {
+            best = Steps(neighbor) + 1;
+         }
+      }
+      if (best != Unreached) {
+         nearest.emplace(best, node);
+      }
+   }
+
+   //Settle the offers nearest first, so each lost node keeps the first distance it is given.
+   while (!nearest.empty()) {
+      //Some offer has not been settled yet.
+
+      std::pair<std::uint32_t, std::uint32_t> offer = nearest.top();
+      nearest.pop();
+      if (offer.first >= Steps(offer.second)) {
+         continue;
+      }
+      Steps(offer.second) = offer.first;
+      for (std::uint32_t neighbor : Neighbors(offer.second)) {
+         //Every neighbor of this node has not been offered a distance through it yet.
+
+         if (offer.first + 1 < Steps(neighbor)) {
+            nearest.emplace(offer.first + 1, neighbor);
+         }
+      }
+   }
+   repairCount += lost.size();
+}
+
+/*
+Purpose:          Check if a node has a neighbor one step nearer the center that is not being repaired.
+Parameters:       node, the node to check.
+Preconditions:    A LiveGraph object has been instantiated.
+Postconditions:   Nothing in the LiveGraph changes.
+Return value:     True if such a neighbor exists, so the node keeps its distance.
+Functions Called: Steps() and Neighbors().
+*/
+bool LiveGraph::HasParent(std::uint32_t node) const {
+
+   //Local Variables
+   std::uint32_t steps = Steps(node);
+
+   //The center needs no parent.
+   if (steps == 0) {
+      return true;
+   }
+   for (std::uint32_t neighbor : Neighbors(node)) {
+      //Every neighbor of this node has not been checked yet.
+
+      if (Steps(neighbor) != Unreached && Steps(neighbor) + 1 == steps && !Marked(neighbor)) {
+         return true;
+      }
+   }
+   return false;
+}
+
+/*
+Purpose:          Check if a node is being repaired by the current call to Repair.
+Parameters:       node, the node to check.
+Preconditions:    A LiveGraph object has been instantiated.
+Postconditions:   Nothing in the LiveGraph changes.
+Return value:     True if the node has been marked with the current stamp.
+Functions Called: None.
+*/
+bool LiveGraph::Marked(std::uint32_t node) const {
+   return ((node & MovieNode) ? movieMark[node & ~MovieNode] : actorMark[node]) == stamp;
+}
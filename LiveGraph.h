@@ -0,0 +1,247 @@
+/*
+File Name:  LiveGraph.h
+Author:     Logan Petersen
+Date:       Febuary 2, 2020
+Purpose:    This is the header file for the LiveGraph class containing LiveGraph's interface.
+            A LiveGraph lets a loaded Graph change, adding and removing actors/actresses and their
+            credits, while keeping every distance from one center up to date. It holds its own copy
+            of the credits, with actors/actresses and movies as the two sides of one graph, so the
+            Graph and any snapshot it is mapped from are left as they are. Names and movies that are
+            new to the Graph are kept by the LiveGraph, and are given the ids after the Graph's own.
+
+            Distances are kept in steps of that graph, where an actor/actress's step count is twice
+            their Bacon number and a movie's is one more than the nearest of its cast. Adding a credit
+            only lowers distances, and only from the new credit outward. Removing one leaves alone
+            every actor/actress and movie that still has a neighbor one step nearer the center; only
+            those that lose every such neighbor are searched again, starting from the nearest of their
+            neighbors that kept a distance. Either way the work grows with what changed rather than
+            with the size of the Graph.
+
+            Updates can be read one per line, with tabs between the parts:
+
+               +<TAB>name<TAB>movie   Give name a credit for movie, adding either if they are new.
+               +<TAB>name             Add name with no credits, if they are new.
+               -<TAB>name<TAB>movie   Take away name's credit for movie.
+               -<TAB>name             Remove name and all of their credits.
+
+            Names are written as in the actors list. Movies may be written as they are in the actors
+            list too, such as "A Very Interesting Movie (2020) {Pilot}", since each is cleaned the way
+            the parser cleans them before it is looked up, giving "AVeryInterestingMovie(2020)".
+*/
+
+#pragma once
+
+#include "Graph.h"
+#include <cstdint>     //Grants the fixed width integers ids and distances are made of.
+#include <cstddef>     //Grants size_t for counting what an update touched.
+#include <string_view> //Grants string_view, which is how names and movies are handed to the LiveGraph.
+#include <vector>      //Grants the vectors the credits and casts are kept in.
+
+class LiveGraph {
+public:
+   /*
+   Purpose:          Construct the LiveGraph for a Graph, measuring every distance from the Graph's center.
+   Parameters:       graph, the Graph to start from. It must be frozen and must outlive the LiveGraph.
+   Preconditions:    This specific LiveGraph object has not been instantiated.
+   Postconditions:   LiveGraph object has been instantiated with a copy of the Graph's credits and the distance of
+                     every actor/actress and movie from the center, if the center is in the Graph.
+   Return value:     None.
+   Functions Called: Graph::ComputeDistances(), which gives the first distances.
+   */
+   explicit LiveGraph(const Graph& graph);
+
+   /*
+   Purpose:          Give an actor/actress a credit for a movie, adding either if they are new.
+   Parameters:       name, the actor/actress's name as written in the actors list.
+                     movie, the movie's name as the parser leaves it.
+   Preconditions:    A LiveGraph object has been instantiated.
+   Postconditions:   The credit is in the LiveGraph, and every distance it shortened has been lowered.
+   Return value:     True if the credit is new, false if the actor/actress already had it.
+   Functions Called: Lower(), which lowers the distances the credit shortens.
+   */
+   bool AddCredit(std::string_view name, std::string_view movie);
+
+   /*
+   Purpose:          Add an actor/actress with no credits.
+   Parameters:       name, the actor/actress's name as written in the actors list.
+   Preconditions:    A LiveGraph object has been instantiated.
+   Postconditions:   The actor/actress is in the LiveGraph. They cannot be reached until they are given a credit.
+   Return value:     True if the actor/actress is new, false if they were already in the LiveGraph.
+   Functions Called: None.
+   */
+   bool AddActor(std::string_view name);
+
+   /*
+   Purpose:          Take away an actor/actress's credit for a movie.
+   Parameters:       name, the actor/actress's name as written in the actors list.
+                     movie, the movie's name as the parser leaves it.
+   Preconditions:    A LiveGraph object has been instantiated.
+   Postconditions:   The credit is gone, and every distance that depended on it has been repaired.
+   Return value:     True if the credit was taken away, false if there was no such credit.
+   Functions Called: Repair(), which repairs the distances that depended on the credit.
+   */
+   bool RemoveCredit(std::string_view name, std::string_view movie);
+
+   /*
+   Purpose:          Remove an actor/actress and all of their credits.
+   Parameters:       name, the actor/actress's name as written in the actors list.
+   Preconditions:    A LiveGraph object has been instantiated.
+   Postconditions:   The actor/actress is no longer listed, and every distance that depended on their credits has been
+                     repaired. Adding them again brings them back with no credits.
+   Return value:     True if the actor/actress was removed, false if they were not in the LiveGraph.
+   Functions Called: Repair(), once for each credit.
+   */
+   bool RemoveActor(std::string_view name);
+
+   /*
+   Purpose:          Apply one update written as described at the top of this file.
+   Parameters:       line, the update.
+   Preconditions:    A LiveGraph object has been instantiated.
+   Postconditions:   The update has been applied if it is well formed.
+   Return value:     False if the line is not an update, true otherwise, even if the update changed nothing.
+   Functions Called: ActorListParser::Next(), which cleans the movie as the actors list's movies are cleaned,
+                     AddCredit(), AddActor(), RemoveCredit() and RemoveActor().
+   */
+   bool Apply(std::string_view line);
+
+   /*
+   Purpose:          Print every actor/actress and their distance from the center on seperate lines, in the same
+                     order and format as Graph::GenerateNumbers.
+   Parameters:       out, the writer the lines are printed through.
+   Preconditions:    A LiveGraph object has been instantiated.
+   Postconditions:   Every line has been given to out.
+   Return value:     None.
+   Functions Called: Graph::AddedPosition(), which keeps the Graph's actors/actresses in the order they were added.
+   */
+   void Write(OutputWriter& out) const;
+
+   /*
+   Purpose:          Check every distance against a full breadth first search of the LiveGraph from the center.
+   Parameters:       None.
+   Preconditions:    A LiveGraph object has been instantiated.
+   Postconditions:   Nothing in the LiveGraph changes.
+   Return value:     True if every actor/actress and movie has the distance the full search gives it.
+   Functions Called: None.
+   */
+   bool Verify() const;
+
+   /*
+   Purpose:          Report how much the last update touched.
+   Parameters:       None.
+   Preconditions:    A LiveGraph object has been instantiated.
+   Postconditions:   Nothing in the LiveGraph changes.
+   Return value:     The number of actors/actresses and movies whose distance the last update changed or searched again.
+   Functions Called: None.
+   */
+   std::size_t LastRepairCount() const;
+private:
+   static constexpr std::uint32_t Unreached = 0xFFFFFFFF; //The distance of what cannot be reached from the center.
+   static constexpr std::uint32_t MovieNode = 0x80000000; //Set in a node's id when it is a movie rather than a Vertex.
+
+   /*
+   Purpose:          Find an actor/actress's id, in the Graph or among those added since.
+   Parameters:       name, the actor/actress's name as written in the actors list.
+   Preconditions:    A LiveGraph object has been instantiated.
+   Postconditions:   Nothing in the LiveGraph changes.
+   Return value:     The id, or Graph::NoVertex if the name is in neither. A removed actor/actress still has an id.
+   Functions Called: Graph::Find() and StringArena::Find().
+   */
+   std::uint32_t FindActor(std::string_view name) const;
+
+   /*
+   Purpose:          Find a movie's id, in the Graph or among those added since.
+   Parameters:       movie, the movie's name as the parser leaves it.
+   Preconditions:    A LiveGraph object has been instantiated.
+   Postconditions:   Nothing in the LiveGraph changes.
+   Return value:     The id, or Graph::NoVertex if the movie is in neither.
+   Functions Called: Graph::FindMovie() and StringArena::Find().
+   */
+   std::uint32_t FindMovie(std::string_view movie) const;
+
+   /*
+   Purpose:          Give the name of an actor/actress, from the Graph or from those added since.
+   Parameters:       id, the actor/actress's id.
+   Preconditions:    id is in the LiveGraph.
+   Postconditions:   Nothing in the LiveGraph changes.
+   Return value:     The name.
+   Functions Called: Graph::NameOf() and StringArena::Get().
+   */
+   std::string_view NameOf(std::uint32_t id) const;
+
+   /*
+   Purpose:          Give the distance of a node.
+   Parameters:       node, an actor/actress's id, or a movie's id with MovieNode set.
+   Preconditions:    node is in the LiveGraph.
+   Postconditions:   Nothing in the LiveGraph changes.
+   Return value:     A reference to the node's distance in steps, or Unreached.
+   Functions Called: None.
+   */
+   std::uint32_t& Steps(std::uint32_t node);
+   std::uint32_t Steps(std::uint32_t node) const;
+
+   /*
+   Purpose:          Give the neighbors of a node.
+   Parameters:       node, an actor/actress's id, or a movie's id with MovieNode set.
+   Preconditions:    node is in the LiveGraph.
+   Postconditions:   Nothing in the LiveGraph changes.
+   Return value:     An actor/actress's movies with MovieNode set, or a movie's cast.
+   Functions Called: None.
+   */
+   const std::vector<std::uint32_t>& Neighbors(std::uint32_t node) const;
+
+   /*
+   Purpose:          Lower the distances a new link between two nodes shortens, moving outward from the link.
+   Parameters:       from and to, the two nodes, where to is the one that may now be nearer.
+   Preconditions:    The link is in the LiveGraph, and every distance was right before it was added.
+   Postconditions:   Every distance is right.
+   Return value:     None.
+   Functions Called: Steps() and Neighbors().
+   */
+   void Lower(std::uint32_t from, std::uint32_t to);
+
+   /*
+   Purpose:          Repair the distances that depended on a link between two nodes that has been taken away.
+   Parameters:       first and second, the two nodes.
+   Preconditions:    The link is no longer in the LiveGraph, and every distance was right before it was taken away.
+   Postconditions:   Every distance is right.
+   Return value:     None.
+   Functions Called: HasParent(), Steps() and Neighbors().
+   */
+   void Repair(std::uint32_t first, std::uint32_t second);
+
+   /*
+   Purpose:          Check if a node has a neighbor one step nearer the center that is not being repaired.
+   Parameters:       node, the node to check.
+   Preconditions:    A LiveGraph object has been instantiated.
+   Postconditions:   Nothing in the LiveGraph changes.
+   Return value:     True if such a neighbor exists, so the node keeps its distance.
+   Functions Called: Steps() and Neighbors().
+   */
+   bool HasParent(std::uint32_t node) const;
+
+   /*
+   Purpose:          Check if a node is being repaired by the current call to Repair.
+   Parameters:       node, the node to check.
+   Preconditions:    A LiveGraph object has been instantiated.
+   Postconditions:   Nothing in the LiveGraph changes.
+   Return value:     True if the node has been marked with the current stamp.
+   Functions Called: None.
+   */
+   bool Marked(std::uint32_t node) const;
+
+   const Graph& graph;                              //The Graph the LiveGraph started from.
+   std::uint32_t center;                            //The id of the center, or Graph::NoVertex if it is not in the Graph.
+   std::size_t baseActors;                          //The number of actors/actresses in the Graph.
+   std::size_t baseMovies;                          //The number of movies in the Graph.
+   StringArena addedNames;                          //The names added since, with ids counted from baseActors.
+   StringArena addedMovies;                         //The movies added since, with ids counted from baseMovies.
+   std::vector<std::vector<std::uint32_t>> credits; //Every actor/actress's movies, each with MovieNode set.
+   std::vector<std::vector<std::uint32_t>> casts;   //Every movie's cast.
+   std::vector<bool> removed;                       //True for each actor/actress that has been removed.
+   std::vector<std::uint32_t> actorSteps;           //Every actor/actress's distance in steps, or Unreached.
+   std::vector<std::uint32_t> movieSteps;           //Every movie's distance in steps, or Unreached.
+   std::vector<std::uint32_t> actorMark;            //stamp once Repair finds an actor/actress that lost its distance.
+   std::vector<std::uint32_t> movieMark;            //stamp once Repair finds a movie that lost its distance.
+   std::uint32_t stamp;                             //The mark of the current call to Repair.
+   std::size_t repairCount;                         //The nodes touched since the last update began.
+};
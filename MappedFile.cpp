@@ -0,0 +1,159 @@
+/*
+File Name:  MappedFile.cpp
+Author:     Logan Petersen
+Date:       Febuary 2, 2020
+Purpose:    The purpose of this code is to be the function definitions for
+            the prototypes in MappedFile.h. On POSIX systems the file is mapped
+            with mmap, and everywhere else it is read into a buffer in one call.
+*/
+
+#include "MappedFile.h"
+#include <utility> //Grants swap, for exchanging mappings.
+
+#ifdef _WIN32
+#include <fstream> //Grants file reading, for reading the file into the buffer.
+#else
+#include <sys/mman.h> //Grants mmap and munmap.
+#include <sys/stat.h> //Grants fstat, for the size of the file.
+#include <fcntl.h>    //Grants open.
+#include <unistd.h>   //Grants close.
+#endif
+
+/*
+Purpose:          Construct the MappedFile when it is created without arguments.
+Parameters:       None.
+Preconditions:    This specific MappedFile object has not been instantiated.
+Postconditions:   MappedFile object has been instantiated with nothing mapped.
+Return value:     None.
+Functions Called: None.
+*/
+MappedFile::MappedFile() {
+   data = nullptr;
+   size = 0;
+}
+
+/*
+Purpose:          Unmap the file mapped by this MappedFile object.
+Parameters:       None.
+Preconditions:    This specific MappedFile object has left scope and is slated for deletion.
+Postconditions:   The mapping has been released.
+Return value:     None.
+Functions Called: Close(), which releases the mapping.
+*/
+MappedFile::~MappedFile() {
+   Close();
+}
+
+/*
+Purpose:          Map a file into memory.
+Parameters:       path, the location of the file to map.
+Preconditions:    A MappedFile object has been instantiated.
+Postconditions:   Any previous mapping is released. If the file could be opened, Data() points at its contents.
+Return value:     True if the file was opened and mapped, false otherwise. An empty file is opened with no data.
+Functions Called: Close(), which releases any previous mapping.
+*/
+bool MappedFile::Open(const char* path) {
+   Close();
+
+#ifdef _WIN32
+   std::ifstream file(path, std::ios::binary | std::ios::ate);
+
+   if (!file) {
+      return false;
+   }
+   buffer.resize(static_cast<std::size_t>(file.tellg()));
+   file.seekg(0);
+   file.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+   data = buffer.empty() ? nullptr : buffer.data();
+   size = buffer.size();
+   return true;
+#else
+   //Local variables
+   struct stat status;
+   void* mapping;
+   int descriptor = open(path, O_RDONLY);
+
+   if (descriptor == -1) {
+      return false;
+   }
+   if (fstat(descriptor, &status) == -1) {
+      close(descriptor);
+      return false;
+   }
+
+   //mmap refuses empty mappings, but an empty file is still a file that opened.
+   if (status.st_size == 0) {
+      close(descriptor);
+      return true;
+   }
+
+   //A private mapping lets the parser write into pages it has read without changing the file.
+   mapping = mmap(nullptr, static_cast<std::size_t>(status.st_size), PROT_READ | PROT_WRITE, MAP_PRIVATE, descriptor, 0);
+   close(descriptor);
+   if (mapping == MAP_FAILED) {
+      return false;
+   }
+   madvise(mapping, static_cast<std::size_t>(status.st_size), MADV_SEQUENTIAL);
+   data = static_cast<char*>(mapping);
+   size = static_cast<std::size_t>(status.st_size);
+   return true;
+#endif
+}
+
+/*
+Purpose:          Release the mapping.
+Parameters:       None.
+Preconditions:    A MappedFile object has been instantiated.
+Postconditions:   Nothing is mapped, and Data() is nullptr.
+Return value:     None.
+Functions Called: None.
+*/
+void MappedFile::Close() {
+#ifdef _WIN32
+   std::vector<char>().swap(buffer);
+#else
+   if (data != nullptr) {
+      munmap(data, size);
+   }
+#endif
+   data = nullptr;
+   size = 0;
+}
+
+/*
+Purpose:          Exchange mappings with another MappedFile.
+Parameters:       other, the MappedFile to exchange with.
+Preconditions:    A MappedFile object has been instantiated.
+Postconditions:   Each MappedFile holds what the other held.
+Return value:     None.
+Functions Called: None.
+*/
+void MappedFile::Swap(MappedFile& other) {
+   std::swap(data, other.data);
+   std::swap(size, other.size);
+   buffer.swap(other.buffer);
+}
+
+/*
+Purpose:          Give the start of the mapped file.
+Parameters:       None.
+Preconditions:    A MappedFile object has been instantiated.
+Postconditions:   Nothing in the MappedFile changes.
+Return value:     A pointer to the first byte of the file, or nullptr when nothing is mapped.
+Functions Called: None.
+*/
+char* MappedFile::Data() const {
+   return data;
+}
+
+/*
+Purpose:          Give the size of the mapped file.
+Parameters:       None.
+Preconditions:    A MappedFile object has been instantiated.
+Postconditions:   Nothing in the MappedFile changes.
+Return value:     The number of bytes mapped.
+Functions Called: None.
+*/
+std::size_t MappedFile::Size() const {
+   return size;
+}
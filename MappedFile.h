@@ -0,0 +1,95 @@
+/*
+File Name:  MappedFile.h
+Author:     Logan Petersen
+Date:       Febuary 2, 2020
+Purpose:    This is the header file for the MappedFile class containing MappedFile's interface.
+            MappedFile maps a whole file into memory so that it can be scanned without copying it
+            through a stream. The mapping is private and writable, so the parser may rewrite bytes
+            it has already read without the changes ever reaching the file on disk.
+*/
+
+#pragma once
+
+#include <cstddef> //Grants size_t for the size of the mapping.
+#include <vector>  //Grants the vector used to hold the file on systems without mmap.
+
+class MappedFile {
+public:
+   /*
+   Purpose:          Construct the MappedFile when it is created without arguments.
+   Parameters:       None.
+   Preconditions:    This specific MappedFile object has not been instantiated.
+   Postconditions:   MappedFile object has been instantiated with nothing mapped.
+   Return value:     None.
+   Functions Called: None.
+   */
+   MappedFile();
+
+   /*
+   Purpose:          Unmap the file mapped by this MappedFile object.
+   Parameters:       None.
+   Preconditions:    This specific MappedFile object has left scope and is slated for deletion.
+   Postconditions:   The mapping has been released.
+   Return value:     None.
+   Functions Called: Close(), which releases the mapping.
+   */
+   ~MappedFile();
+
+   //A mapping cannot be shared between two objects, since both would release it.
+   MappedFile(const MappedFile&) = delete;
+   MappedFile& operator=(const MappedFile&) = delete;
+
+   /*
+   Purpose:          Map a file into memory.
+   Parameters:       path, the location of the file to map.
+   Preconditions:    A MappedFile object has been instantiated.
+   Postconditions:   Any previous mapping is released. If the file could be opened, Data() points at its contents.
+   Return value:     True if the file was opened and mapped, false otherwise. An empty file is opened with no data.
+   Functions Called: Close(), which releases any previous mapping.
+   */
+   bool Open(const char* path);
+
+   /*
+   Purpose:          Release the mapping.
+   Parameters:       None.
+   Preconditions:    A MappedFile object has been instantiated.
+   Postconditions:   Nothing is mapped, and Data() is nullptr.
+   Return value:     None.
+   Functions Called: None.
+   */
+   void Close();
+
+   /*
+   Purpose:          Exchange mappings with another MappedFile.
+   Parameters:       other, the MappedFile to exchange with.
+   Preconditions:    A MappedFile object has been instantiated.
+   Postconditions:   Each MappedFile holds what the other held.
+   Return value:     None.
+   Functions Called: None.
+   */
+   void Swap(MappedFile& other);
+
+   /*
+   Purpose:          Give the start of the mapped file.
+   Parameters:       None.
+   Preconditions:    A MappedFile object has been instantiated.
+   Postconditions:   Nothing in the MappedFile changes.
+   Return value:     A pointer to the first byte of the file, or nullptr when nothing is mapped.
+   Functions Called: None.
+   */
+   char* Data() const;
+
+   /*
+   Purpose:          Give the size of the mapped file.
+   Parameters:       None.
+   Preconditions:    A MappedFile object has been instantiated.
+   Postconditions:   Nothing in the MappedFile changes.
+   Return value:     The number of bytes mapped.
+   Functions Called: None.
+   */
+   std::size_t Size() const;
+private:
+   char* data;               //The first byte of the mapping.
+   std::size_t size;         //The number of bytes in the mapping.
+   std::vector<char> buffer; //Holds the file when the system has no mmap.
+};
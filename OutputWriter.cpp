@@ -0,0 +1,124 @@
+/*
+File Name:  OutputWriter.cpp
+Author:     Logan Petersen
+Date:       Febuary 2, 2020
+Purpose:    The purpose of this code is to be the function definitions for
+            the prototypes in OutputWriter.h.
+*/
+
+#include "OutputWriter.h"
+#include <charconv> //Grants to_chars, which formats numbers without building a string.
+#include <cstring>  //Grants memcpy, for copying text into the buffer.
+
+/*
+Purpose:          Construct the OutputWriter for a stream.
+Parameters:       out, the stream everything is written to.
+Preconditions:    This specific OutputWriter object has not been instantiated.
+Postconditions:   OutputWriter object has been instantiated with an empty buffer.
+Return value:     None.
+Functions Called: None.
+*/
+OutputWriter::OutputWriter(std::ostream& out) : out(out), buffer(new char[BufferSize]), used(0) {}
+
+/*
+Purpose:          Write out whatever is left in the buffer.
+Parameters:       None.
+Preconditions:    This specific OutputWriter object has left scope and is slated for deletion.
+Postconditions:   Everything written has reached the stream.
+Return value:     None.
+Functions Called: Flush(), which writes the buffer.
+*/
+OutputWriter::~OutputWriter() {
+   Flush();
+}
+
+/*
+Purpose:          Add text to the output.
+Parameters:       text, the text to add.
+Preconditions:    An OutputWriter object has been instantiated.
+Postconditions:   text is in the buffer, or has been written if the buffer filled up.
+Return value:     None.
+Functions Called: None.
+*/
+void OutputWriter::Write(std::string_view text) {
+   while (used + text.size() > BufferSize) {
+      //The text does not fit in what is left of the buffer.
+
+      std::size_t room = BufferSize - used;
+      std::memcpy(buffer.get() + used, text.data(), room);
+      used += room;
+      text.remove_prefix(room);
+      out.write(buffer.get(), static_cast<std::streamsize>(used));
+      used = 0;
+   }
+   std::memcpy(buffer.get() + used, text.data(), text.size());
+   used += text.size();
+}
+
+/*
+Purpose:          Add a character to the output.
+Parameters:       character, the character to add.
+Preconditions:    An OutputWriter object has been instantiated.
+Postconditions:   character is in the buffer, or has been written if the buffer filled up.
+Return value:     None.
+Functions Called: None.
+*/
+void OutputWriter::Write(char character) {
+   if (used == BufferSize) {
+      out.write(buffer.get(), static_cast<std::streamsize>(used));
+      used = 0;
+   }
+   buffer[used++] = character;
+}
+
+/*
+Purpose:          Add a number to the output in decimal, formatted with to_chars.
+Parameters:       number, the number to add.
+Preconditions:    An OutputWriter object has been instantiated.
+Postconditions:   The digits are in the buffer, or have been written if the buffer filled up.
+Return value:     None.
+Functions Called: Write(), which adds the digits.
+*/
+void OutputWriter::WriteNumber(long long number) {
+
+   //Local Variables
+   char digits[24]; //Room for every digit and the sign of any long long.
+   std::to_chars_result result = std::to_chars(digits, digits + sizeof(digits), number);
+
+   Write(std::string_view(digits, static_cast<std::size_t>(result.ptr - digits)));
+}
+
+/*
+Purpose:          Add a number to the output in decimal with a fixed number of places, formatted with to_chars.
+Parameters:       number, the number to add.
+                  places, the number of digits after the decimal point.
+Preconditions:    An OutputWriter object has been instantiated.
+Postconditions:   The digits are in the buffer, or have been written if the buffer filled up.
+Return value:     None.
+Functions Called: Write(), which adds the digits.
+*/
+void OutputWriter::WriteDecimal(double number, int places) {
+
+   //Local Variables
+   char digits[64]; //Room for any number this program prints.
+   std::to_chars_result result = std::to_chars(digits, digits + sizeof(digits), number, std::chars_format::fixed, places);
+
+   //A number too long for the room is left out rather than cut short.
+   if (result.ec == std::errc()) {
+      Write(std::string_view(digits, static_cast<std::size_t>(result.ptr - digits)));
+   }
+}
+
+/*
+Purpose:          Write the buffer to the stream and flush the stream, so that the output so far can be seen.
+Parameters:       None.
+Preconditions:    An OutputWriter object has been instantiated.
+Postconditions:   The buffer is empty and everything written has reached the stream.
+Return value:     None.
+Functions Called: None.
+*/
+void OutputWriter::Flush() {
+   out.write(buffer.get(), static_cast<std::streamsize>(used));
+   out.flush();
+   used = 0;
+}
@@ -0,0 +1,100 @@
+/*
+File Name:  OutputWriter.h
+Author:     Logan Petersen
+Date:       Febuary 2, 2020
+Purpose:    This is the header file for the OutputWriter class containing OutputWriter's interface.
+            An OutputWriter gathers text in a fixed size buffer and hands it to an ostream one large
+            block at a time, so printing millions of lines costs a few large writes instead of one
+            small write per line, and the output never needs more memory than the buffer.
+*/
+
+#pragma once
+
+#include <ostream>     //Grants ostream, which the buffer is written to.
+#include <string_view> //Grants string_view, for the text written.
+#include <cstddef>     //Grants size_t for the size of the buffer.
+#include <memory>      //Grants unique_ptr, which owns the buffer.
+
+class OutputWriter {
+public:
+   static constexpr std::size_t BufferSize = 1 << 20; //The bytes gathered before they are written.
+
+   /*
+   Purpose:          Construct the OutputWriter for a stream.
+   Parameters:       out, the stream everything is written to.
+   Preconditions:    This specific OutputWriter object has not been instantiated.
+   Postconditions:   OutputWriter object has been instantiated with an empty buffer.
+   Return value:     None.
+   Functions Called: None.
+   */
+   explicit OutputWriter(std::ostream& out);
+
+   /*
+   Purpose:          Write out whatever is left in the buffer.
+   Parameters:       None.
+   Preconditions:    This specific OutputWriter object has left scope and is slated for deletion.
+   Postconditions:   Everything written has reached the stream.
+   Return value:     None.
+   Functions Called: Flush(), which writes the buffer.
+   */
+   ~OutputWriter();
+
+   //Two writers would each hold part of the same output.
+   OutputWriter(const OutputWriter&) = delete;
+   OutputWriter& operator=(const OutputWriter&) = delete;
+
+   /*
+   Purpose:          Add text to the output.
+   Parameters:       text, the text to add.
+   Preconditions:    An OutputWriter object has been instantiated.
+   Postconditions:   text is in the buffer, or has been written if the buffer filled up.
+   Return value:     None.
+   Functions Called: None.
+   */
+   void Write(std::string_view text);
+
+   /*
+   Purpose:          Add a character to the output.
+   Parameters:       character, the character to add.
+   Preconditions:    An OutputWriter object has been instantiated.
+   Postconditions:   character is in the buffer, or has been written if the buffer filled up.
+   Return value:     None.
+   Functions Called: None.
+   */
+   void Write(char character);
+
+   /*
+   Purpose:          Add a number to the output in decimal, formatted with to_chars.
+   Parameters:       number, the number to add.
+   Preconditions:    An OutputWriter object has been instantiated.
+   Postconditions:   The digits are in the buffer, or have been written if the buffer filled up.
+   Return value:     None.
+   Functions Called: Write(), which adds the digits.
+   */
+   void WriteNumber(long long number);
+
+   /*
+   Purpose:          Add a number to the output in decimal with a fixed number of places, formatted with to_chars.
+   Parameters:       number, the number to add.
+                     places, the number of digits after the decimal point.
+   Preconditions:    An OutputWriter object has been instantiated.
+   Postconditions:   The digits are in the buffer, or have been written if the buffer filled up.
+   Return value:     None.
+   Functions Called: Write(), which adds the digits.
+   */
+   void WriteDecimal(double number, int places);
+
+   /*
+   Purpose:          Write the buffer to the stream and flush the stream, so that the output so far can be seen.
+   Parameters:       None.
+   Preconditions:    An OutputWriter object has been instantiated.
+   Postconditions:   The buffer is empty and everything written has reached the stream.
+   Return value:     None.
+   Functions Called: None.
+   */
+   void Flush();
+private:
+   std::ostream& out;               //The stream everything is written to.
+   std::unique_ptr<char[]> buffer;  //The text not yet written to the stream.
+   std::size_t used;                //The number of bytes of buffer in use.
+};
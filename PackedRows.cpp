@@ -0,0 +1,94 @@
+/*
+File Name:  PackedRows.cpp
+Author:     Logan Petersen
+Date:       Febuary 2, 2020
+Purpose:    The purpose of this code is to be the function definitions for
+            the prototypes in PackedRows.h, along with the tables its readers
+            unpack each group of four gaps with.
+*/
+
+#include "PackedRows.h"
+
+namespace {
+
+   /*
+   Purpose:          Work out the tables for every control byte from the four two bit lengths it holds.
+   Parameters:       None.
+   Preconditions:    None.
+   Postconditions:   Nothing changes.
+   Return value:     The tables.
+   Functions Called: None.
+   */
+   constexpr PackedGroupTables BuildTables() {
+
+      //Local Variables
+      PackedGroupTables tables = {};
+
+      for (int code = 0; code < 256; code++) {
+         //Every control byte has not been worked out yet.
+
+         int position = 0; //Where the next gap starts in the group's bytes.
+         for (int i = 0; i < 4; i++) {
+            //Every gap of the group has not been placed yet.
+
+            int length = ((code >> (2 * i)) & 3) + 1;
+            for (int byte = 0; byte < 4; byte++) {
+               //Every byte of this gap's 32 bits has not been given a source yet.
+
+               //A shuffle index with its top bit set gives a zero byte.
+               tables.shuffles[code][4 * i + byte] = static_cast<std::uint8_t>(byte < length ? position + byte : 0x80);
+            }
+            position += length;
+         }
+         tables.bytes[code] = static_cast<std::uint8_t>(position);
+      }
+      return tables;
+   }
+}
+
+const PackedGroupTables PackedTables = BuildTables();
+
+/*
+Purpose:          Pack a row onto the end of an array of rows.
+Parameters:       ids, the row, in increasing order.
+                  count, the number of ids in the row.
+                  bytes, the array the row is added to.
+Preconditions:    Every id is larger than the one before it.
+Postconditions:   The packed row has been added to the end of bytes.
+Return value:     None.
+Functions Called: None.
+*/
+void AppendPackedRow(const std::uint32_t* ids, std::size_t count, std::vector<std::uint8_t>& bytes) {
+
+   //Local Variables
+   std::size_t remaining = count;
+   std::size_t control;        //Where the control bytes start.
+   std::uint32_t previous = 0; //The id before the one being packed.
+
+   while (remaining >= 0x80) {
+      //The count does not fit in the bytes written so far.
+
+      bytes.push_back(static_cast<std::uint8_t>(remaining | 0x80));
+      remaining >>= 7;
+   }
+   bytes.push_back(static_cast<std::uint8_t>(remaining));
+
+   //The control bytes are filled in as the gaps are written after them. The gaps missing from a last group of fewer
+   //than four are given a length of one byte and never written.
+   control = bytes.size();
+   bytes.resize(bytes.size() + (count + 3) / 4, 0);
+   for (std::size_t i = 0; i < count; i++) {
+      //Every id has not been packed yet.
+
+      std::uint32_t gap = ids[i] - previous;
+      int length = gap < (1u << 8) ? 1 : gap < (1u << 16) ? 2 : gap < (1u << 24) ? 3 : 4;
+
+      bytes[control + i / 4] |= static_cast<std::uint8_t>((length - 1) << (2 * (i % 4)));
+      for (int byte = 0; byte < length; byte++) {
+         //Every byte of this gap has not been written yet.
+
+         bytes.push_back(static_cast<std::uint8_t>(gap >> (8 * byte)));
+      }
+      previous = ids[i];
+   }
+}
@@ -0,0 +1,145 @@
+/*
+File Name:  PackedRows.h
+Author:     Logan Petersen
+Date:       Febuary 2, 2020
+Purpose:    This is the header file for packed rows, the compressed form a Graph can freeze its rows
+            in. A row is a list of ids in increasing order, such as an actor/actress's co-stars. It is
+            stored as the number of ids, written as a varint, followed by the gaps between the ids in
+            the StreamVByte layout: one control byte for every four gaps, giving each gap's length in
+            bytes as two bits, followed by the gaps themselves in 1 to 4 little endian bytes each.
+            Ids that sit close together, as they do once the vertices are renumbered with --order,
+            have small gaps that mostly fit in one byte, so the rows take well under half the memory
+            of 32 bit ids.
+
+            Rows are read back one group of four at a time. When the compiler targets SSSE3, such as
+            with -mssse3 or -march=native, each group is unpacked with one shuffle picked by its
+            control byte, and the gaps are added up in the same register. Otherwise each gap is
+            read as 4 bytes with those past its length masked off. Either way a reader may look up to
+            PackedPadding bytes past the end of the last row, so the array the rows are stored in must
+            be followed by that many bytes.
+*/
+
+#pragma once
+
+#include <cstdint> //Grants the fixed width integers the rows are made of.
+#include <cstddef> //Grants size_t for the lengths of rows.
+#include <vector>  //Grants the vector rows are packed onto.
+#ifdef __SSSE3__
+#include <tmmintrin.h> //Grants the SSSE3 shuffle that unpacks a group of gaps at once.
+#endif
+
+constexpr std::size_t PackedPadding = 16; //The bytes that must follow the last row, since a group is read 16 bytes at a time.
+
+//What a reader needs to know about each control byte, worked out once when compiling.
+struct PackedGroupTables {
+   std::uint8_t bytes[256];        //The bytes the four gaps of a group take.
+   std::uint8_t shuffles[256][16]; //The shuffle that moves each gap of a group into its own 32 bits.
+};
+
+extern const PackedGroupTables PackedTables; //The tables for every control byte.
+
+/*
+Purpose:          Pack a row onto the end of an array of rows.
+Parameters:       ids, the row, in increasing order.
+                  count, the number of ids in the row.
+                  bytes, the array the row is added to.
+Preconditions:    Every id is larger than the one before it.
+Postconditions:   The packed row has been added to the end of bytes.
+Return value:     None.
+Functions Called: None.
+*/
+void AppendPackedRow(const std::uint32_t* ids, std::size_t count, std::vector<std::uint8_t>& bytes);
+
+/*
+Purpose:          Give the number of ids in a packed row, without unpacking them.
+Parameters:       row, the first byte of the row.
+Preconditions:    row starts a row written by AppendPackedRow.
+Postconditions:   Nothing changes.
+Return value:     The number of ids in the row.
+Functions Called: None.
+*/
+inline std::uint32_t PackedRowCount(const std::uint8_t* row) {
+
+   //Local Variables
+   std::uint32_t count = 0;
+   int shift = 0;
+
+   while (*row & 0x80) {
+      //The count has more bytes.
+
+      count |= static_cast<std::uint32_t>(*row++ & 0x7F) << shift;
+      shift += 7;
+   }
+   return count | static_cast<std::uint32_t>(*row) << shift;
+}
+
+/*
+Purpose:          Unpack a row, handing each id to visit in increasing order, until visit asks to stop.
+Parameters:       row, the first byte of the row.
+                  visit, called as visit(id) for each id. It returns false to stop, true to go on.
+Preconditions:    row starts a row written by AppendPackedRow, and PackedPadding bytes follow the last row.
+Postconditions:   Nothing changes.
+Return value:     False if visit stopped the row early, true otherwise.
+Functions Called: visit, once for each id until it returns false.
+*/
+template <typename Visit>
+bool ForEachPacked(const std::uint8_t* row, Visit visit) {
+
+   //Local Variables
+   std::uint32_t count = 0;
+   int shift = 0;
+   const std::uint8_t* control;
+   const std::uint8_t* data;
+   std::uint32_t previous = 0; //The last id unpacked, which the next gap is added to.
+
+   while (*row & 0x80) {
+      //The count has more bytes.
+
+      count |= static_cast<std::uint32_t>(*row++ & 0x7F) << shift;
+      shift += 7;
+   }
+   count |= static_cast<std::uint32_t>(*row++) << shift;
+   control = row;
+   data = row + (count + 3) / 4;
+
+   for (std::uint32_t first = 0; first < count; first += 4) {
+      //Every group of four has not been unpacked yet.
+
+      std::uint8_t code = *control++;
+      std::uint32_t group = count - first < 4 ? count - first : 4;
+#ifdef __SSSE3__
+      alignas(16) std::uint32_t ids[4];
+      __m128i values = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data)),
+                                        _mm_loadu_si128(reinterpret_cast<const __m128i*>(PackedTables.shuffles[code])));
+
+      //Adding each gap to those before it, and then the last id, turns the gaps back into ids.
+      values = _mm_add_epi32(values, _mm_slli_si128(values, 4));
+      values = _mm_add_epi32(values, _mm_slli_si128(values, 8));
+      values = _mm_add_epi32(values, _mm_set1_epi32(static_cast<int>(previous)));
+      _mm_store_si128(reinterpret_cast<__m128i*>(ids), values);
+      data += PackedTables.bytes[code];
+      previous = ids[3];
+#else
+      std::uint32_t ids[4];
+      for (int i = 0; i < 4; i++) {
+         //Every gap of this group has not been unpacked yet.
+
+         //Each gap is read as 4 whole bytes, which the padding allows, and the bytes past its length are masked off.
+         int length = ((code >> (2 * i)) & 3) + 1;
+         std::uint32_t gap = static_cast<std::uint32_t>(data[0]) | static_cast<std::uint32_t>(data[1]) << 8 |
+                             static_cast<std::uint32_t>(data[2]) << 16 | static_cast<std::uint32_t>(data[3]) << 24;
+         data += length;
+         previous += gap & (0xFFFFFFFFu >> (32 - 8 * length));
+         ids[i] = previous;
+      }
+#endif
+      for (std::uint32_t i = 0; i < group; i++) {
+         //Every id of this group has not been visited yet.
+
+         if (!visit(ids[i])) {
+            return false;
+         }
+      }
+   }
+   return true;
+}
@@ -0,0 +1,64 @@
+/*
+File Name:  Parallel.h
+Author:     Logan Petersen
+Date:       Febuary 2, 2020
+Purpose:    This is the header file for the small threading helpers shared by the loader and Graph.
+            ParallelFor splits a range of indices into one contiguous block per thread, and
+            DefaultThreadCount picks how many threads to use when none is given.
+*/
+
+#pragma once
+
+#include <thread>  //Grants thread, which runs each block of the range.
+#include <vector>  //Grants the vector the threads are kept in until they are joined.
+#include <cstddef> //Grants size_t for the range being split.
+
+/*
+Purpose:          Give the number of threads to use when none has been chosen.
+Parameters:       None.
+Preconditions:    None.
+Postconditions:   Nothing changes.
+Return value:     The number of hardware threads, or 1 if that cannot be found.
+Functions Called: None.
+*/
+inline unsigned DefaultThreadCount() {
+   unsigned count = std::thread::hardware_concurrency();
+   return count == 0 ? 1 : count;
+}
+
+/*
+Purpose:          Run body over the indices 0 up to count, split into one contiguous block per thread.
+Parameters:       count, the number of indices in the range.
+                  threadCount, the most threads to use. At least one block is always run.
+                  body, called as body(begin, end, block) for each block, where block numbers the blocks in order.
+Preconditions:    body is safe to run on several blocks at once.
+Postconditions:   body has returned for every block. The last block runs on the calling thread.
+Return value:     None.
+Functions Called: body, once per block.
+*/
+template <typename Body>
+void ParallelFor(std::size_t count, unsigned threadCount, Body body) {
+
+   //Local Variables
+   std::vector<std::thread> threads;
+   std::size_t blocks = threadCount == 0 ? 1 : threadCount;
+
+   //There is no point to blocks with nothing in them.
+   if (blocks > count) {
+      blocks = count == 0 ? 1 : count;
+   }
+
+   threads.reserve(blocks - 1);
+   for (std::size_t block = 0; block + 1 < blocks; block++) {
+      //Every block but the last has not been started yet.
+
+      threads.emplace_back(body, count * block / blocks, count * (block + 1) / blocks, block);
+   }
+   body(count * (blocks - 1) / blocks, count, blocks - 1);
+
+   for (std::thread& i : threads) {
+      //Every thread has not been joined yet.
+
+      i.join();
+   }
+}
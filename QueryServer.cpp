@@ -0,0 +1,471 @@
+/*
+File Name:  QueryServer.cpp
+Author:     Logan Petersen
+Date:       Febuary 2, 2020
+Purpose:    The purpose of this code is to be the function definitions for
+            the prototypes in QueryServer.h. Questions from a stream are taken
+            by whichever worker is free, and each answer is held until every
+            earlier answer has been written, so answers keep the order of questions.
+*/
+
+#include "QueryServer.h"
+#include <map>          //Grants the map holding answers that are waiting for earlier ones.
+#include <sstream>      //Grants ostringstream, which a center's distances are printed into.
+#include <mutex>        //Grants mutex, which guards reading questions and writing answers.
+#include <thread>       //Grants thread, for the workers.
+#include <vector>       //Grants the vector the workers are kept in.
+#include <algorithm>    //Grants min, which caps the wait after accept fails.
+#include <atomic>       //Grants atomic, the flag a client thread sets once it has finished.
+#include <chrono>       //Grants milliseconds, how long the server waits after accept fails.
+#include <list>         //Grants the list the client threads are kept in, so finished ones can be removed.
+#include <memory>       //Grants unique_ptr, which keeps each client's flag in place while the list changes.
+
+#ifndef _WIN32
+#include <sys/socket.h> //Grants socket, bind, listen, accept and shutdown.
+#include <sys/un.h>     //Grants sockaddr_un, the address of a local socket.
+#include <unistd.h>     //Grants read, close and unlink.
+#include <cstring>      //Grants strncpy, for the socket's path.
+#include <cerrno>       //Grants errno, which tells why accept failed.
+
+//A client that hangs up must not kill the server with SIGPIPE. Systems without MSG_NOSIGNAL do not raise it from send.
+#ifdef MSG_NOSIGNAL
+constexpr int SendFlags = MSG_NOSIGNAL;
+#else
+constexpr int SendFlags = 0;
+#endif
+#endif
+
+namespace {
+
+   constexpr std::size_t CachedCenters = 16; //The most centers whose searches the DistanceCache keeps.
+   constexpr int LongestAcceptWait = 1000;    //The most milliseconds the server waits after accept fails again and again.
+
+   //The thread serving one client of the socket.
+   struct SocketClient {
+      std::thread thread;                      //Runs the client.
+      std::unique_ptr<std::atomic<bool>> done; //Set by the thread once the client has hung up, so it can be joined.
+      int socket;                              //The client's connection, or -1 once closed. Guarded by clientsMutex.
+   };
+
+   /*
+   Purpose:          Split a question into its tab separated parts.
+   Parameters:       question, the line to split.
+   Preconditions:    None.
+   Postconditions:   Nothing changes.
+   Return value:     The parts in order, with any carriage return at the end of the line dropped.
+   Functions Called: None.
+   */
+   std::vector<std::string> SplitQuestion(std::string question) {
+      std::vector<std::string> parts(1);
+
+      if (!question.empty() && question.back() == '\r') {
+         question.pop_back();
+      }
+      for (char i : question) {
+         //Every character of the question has not been placed yet.
+
+         if (i == '\t') {
+            parts.emplace_back();
+         }
+         else {
+            parts.back().push_back(i);
+         }
+      }
+      return parts;
+   }
+}
+
+/*
+Purpose:          Construct the server for a Graph.
+Parameters:       graph, the Graph questions are asked about. It must be frozen and must not change while served.
+                  workers, the number of questions answered at once.
+Preconditions:    This specific QueryServer object has not been instantiated.
+Postconditions:   QueryServer object has been instantiated, sharing the Graph's threads between its workers, with
+                  an empty DistanceCache.
+Return value:     None.
+Functions Called: Graph::ThreadCount(), to split the Graph's threads between the workers.
+*/
+QueryServer::QueryServer(const Graph& graph, unsigned workers) : graph(graph), cache(graph, CachedCenters) {
+   this->workers = workers == 0 ? 1 : workers;
+   searchThreads = graph.ThreadCount() / this->workers;
+   if (searchThreads == 0) {
+      searchThreads = 1;
+   }
+}
+
+/*
+Purpose:          Answer one question.
+Parameters:       question, one line holding a command and its arguments.
+                  scratch, the search scratch of the thread answering.
+                  quit, set to true if the question asked to end the session.
+Preconditions:    A QueryServer object has been instantiated.
+Postconditions:   Nothing in the Graph changes, though a distances question may keep its search in the cache.
+Return value:     The answer, ending with an empty line.
+Functions Called: Resolve(), Graph::FindMatching(), Graph::FindPath(), Graph::NameOf(), Graph::TitleOf(),
+                  Graph::GenerateNumbers() and DistanceCache::Lookup().
+*/
+std::string QueryServer::Answer(const std::string& question, Graph::SearchScratch& scratch, bool& quit) const {
+
+   //Local Variables
+   std::vector<std::string> parts = SplitQuestion(question);
+   std::uint32_t from;
+   std::uint32_t to;
+   Graph::Path path;
+   std::string answer;
+
+   quit = false;
+   if (parts[0] == "quit" && parts.size() == 1) {
+      quit = true;
+      return "\n";
+   }
+   if ((parts[0] == "distance" || parts[0] == "path") && parts.size() == 3) {
+      from = Resolve(parts[1], answer);
+      if (from == Graph::NoVertex) {
+         return answer;
+      }
+      to = Resolve(parts[2], answer);
+      if (to == Graph::NoVertex) {
+         return answer;
+      }
+      graph.FindPath(from, to, scratch, path);
+      answer = path.distance == -1 ? "infinity\n" : std::to_string(path.distance) + "\n";
+      if (parts[0] == "path") {
+         for (std::size_t i = 0; i < path.actors.size(); i++) {
+            //Every actor/actress of the chain has not been written yet.
+
+            if (i > 0) {
+               answer += "\t";
+               answer += graph.TitleOf(path.movies[i - 1]);
+               answer += "\n";
+            }
+            answer += graph.NameOf(path.actors[i]);
+            answer += "\n";
+         }
+         answer += "visited\t" + std::to_string(path.visitedVertices) + "\n";
+      }
+      return answer + "\n";
+   }
+   if (parts[0] == "center" && parts.size() == 2) {
+      from = Resolve(parts[1], answer);
+      if (from == Graph::NoVertex) {
+         return answer;
+      }
+      std::ostringstream numbers;
+      {
+         OutputWriter writer(numbers);
+         graph.GenerateNumbers(from, scratch, searchThreads, writer);
+      }
+      return numbers.str() + "\n";
+   }
+   if (parts[0] == "distances" && parts.size() >= 3) {
+      std::vector<std::uint32_t> targets;
+      std::vector<int> distances;
+
+      from = Resolve(parts[1], answer);
+      if (from == Graph::NoVertex) {
+         return answer;
+      }
+      for (std::size_t i = 2; i < parts.size(); i++) {
+         //Every name asked about has not been found yet.
+
+         to = Resolve(parts[i], answer);
+         if (to == Graph::NoVertex) {
+            return answer;
+         }
+         targets.push_back(to);
+      }
+      cache.Lookup(from, targets, scratch, searchThreads, distances);
+      for (std::size_t i = 0; i < targets.size(); i++) {
+         //Every name asked about has not been answered yet.
+
+         answer += graph.NameOf(targets[i]);
+         answer += distances[i] == -1 ? "\tinfinity\n" : "\t" + std::to_string(distances[i]) + "\n";
+      }
+      return answer + "\n";
+   }
+   if (parts[0] == "find" && parts.size() == 2) {
+      std::vector<std::uint32_t> matches;
+
+      graph.FindMatching(parts[1], true, matches);
+      for (std::uint32_t i : matches) {
+         //Every match has not been written yet.
+
+         answer += graph.NameOf(i);
+         answer += "\n";
+      }
+      return answer + "\n";
+   }
+   return "error\tUnknown question. Ask distance<TAB>name<TAB>name, path<TAB>name<TAB>name, center<TAB>name, "
+          "distances<TAB>name<TAB>names, find<TAB>text or quit.\n\n";
+}
+
+/*
+Purpose:          Find the actor/actress a question names. The name is looked up as written, then with case
+                  ignored, then as the start of a name, and the first of these to give exactly one match is used.
+Parameters:       name, the name from the question.
+                  error, set to the error answer when no single actor/actress is found.
+Preconditions:    A QueryServer object has been instantiated.
+Postconditions:   Nothing in the Graph changes.
+Return value:     The id of the actor/actress, or Graph::NoVertex if none or several match.
+Functions Called: Graph::Find() and Graph::FindMatching().
+*/
+std::uint32_t QueryServer::Resolve(const std::string& name, std::string& error) const {
+
+   //Local Variables
+   std::uint32_t id = graph.Find(name);
+   std::vector<std::uint32_t> matches;
+
+   if (id != Graph::NoVertex) {
+      return id;
+   }
+   graph.FindMatching(name, false, matches);
+   if (matches.empty()) {
+      graph.FindMatching(name, true, matches);
+   }
+   if (matches.size() == 1) {
+      return matches[0];
+   }
+   if (matches.empty()) {
+      error = "error\t" + name + " not in Graph.\n\n";
+   }
+   else {
+      error = "error\t" + name + " matches " + std::to_string(matches.size()) + " actors/actresses.\n\n";
+   }
+   return Graph::NoVertex;
+}
+
+/*
+Purpose:          Answer questions read from a stream until it ends or says quit.
+Parameters:       in, the stream questions are read from.
+                  out, the stream answers are written to, in the order the questions were asked.
+Preconditions:    A QueryServer object has been instantiated.
+Postconditions:   Every question read has been answered and out has been flushed after each answer.
+Return value:     None.
+Functions Called: Answer(), which answers each question.
+*/
+void QueryServer::Serve(std::istream& in, std::ostream& out) {
+
+   //Local Variables
+   std::mutex inputMutex;                  //Guards in, nextQuestion and done.
+   std::mutex outputMutex;                 //Guards out, waiting and nextAnswer.
+   std::map<std::size_t, std::string> waiting; //Answers whose earlier answers have not been written yet.
+   std::size_t nextQuestion = 0;           //The number of the next question read.
+   std::size_t nextAnswer = 0;             //The number of the next answer to write.
+   bool done = false;                      //Set once in has ended or said quit.
+   std::vector<std::thread> threads;
+
+   auto work = [&]() {
+      Graph::SearchScratch scratch;
+      std::string question;
+      std::size_t number;
+      bool quit;
+
+      while (true) {
+         //There may be more questions.
+
+         {
+            std::lock_guard<std::mutex> lock(inputMutex);
+            if (done || !std::getline(in, question)) {
+               done = true;
+               return;
+            }
+            number = nextQuestion++;
+
+            //No worker may read past a quit, so it is noticed before the next question is taken.
+            if (question == "quit" || question == "quit\r") {
+               done = true;
+            }
+         }
+
+         std::string answer = Answer(question, scratch, quit);
+
+         //Write this answer and any later ones it was holding up.
+         std::lock_guard<std::mutex> lock(outputMutex);
+         waiting.emplace(number, std::move(answer));
+         while (!waiting.empty() && waiting.begin()->first == nextAnswer) {
+            //The earliest waiting answer is the next one due.
+
+            out << waiting.begin()->second;
+            waiting.erase(waiting.begin());
+            nextAnswer++;
+         }
+         out.flush();
+      }
+   };
+
+   for (unsigned i = 1; i < workers; i++) {
+      //Every worker but this thread has not been started yet.
+
+      threads.emplace_back(work);
+   }
+   work();
+   for (std::thread& i : threads) {
+      //Every worker has not been joined yet.
+
+      i.join();
+   }
+}
+
+/*
+Purpose:          Answer questions from clients of a local socket until a client says shutdown.
+Parameters:       path, the file system path the socket is created at.
+Preconditions:    A QueryServer object has been instantiated.
+Postconditions:   The socket has been removed. Each client was served by its own thread with its own scratch, which
+                  is joined once the client hangs up. Clients still connected once a client says shutdown are hung up
+                  on.
+Return value:     False if the socket could not be created, or if this system has no local sockets, true otherwise.
+Functions Called: Answer(), which answers each question.
+*/
+bool QueryServer::ServeSocket(const char* path) {
+#ifdef _WIN32
+   (void)path;
+   return false;
+#else
+   //Local Variables
+   sockaddr_un address = {};
+   int listener = socket(AF_UNIX, SOCK_STREAM, 0);
+   std::list<SocketClient> clients;
+   std::mutex clientsMutex; //Guards shuttingDown and each client's socket.
+   bool shuttingDown = false;
+   int acceptWait = 0;      //The milliseconds waited after the last failed accept, or 0 if it succeeded.
+
+   if (listener == -1 || std::strlen(path) >= sizeof(address.sun_path)) {
+      if (listener != -1) {
+         close(listener);
+      }
+      return false;
+   }
+   address.sun_family = AF_UNIX;
+   std::strncpy(address.sun_path, path, sizeof(address.sun_path) - 1);
+   unlink(path);
+   if (bind(listener, reinterpret_cast<sockaddr*>(&address), sizeof(address)) == -1 || listen(listener, 16) == -1) {
+      close(listener);
+      return false;
+   }
+
+   while (true) {
+      //No client has said shutdown.
+
+      int client = accept(listener, nullptr, nullptr);
+      {
+         std::lock_guard<std::mutex> lock(clientsMutex);
+         if (shuttingDown) {
+            if (client != -1) {
+               close(client);
+            }
+            break;
+         }
+      }
+
+      //Clients that have hung up are joined as each new one arrives, so a long running server only holds the threads
+      //of clients still connected.
+      for (std::list<SocketClient>::iterator i = clients.begin(); i != clients.end();) {
+         //Every client thread has not been checked yet.
+
+         if (i->done->load()) {
+            i->thread.join();
+            i = clients.erase(i);
+         }
+         else {
+            i++;
+         }
+      }
+
+      //A failure such as running out of file descriptors lasts until some clients hang up, so each failure in a row
+      //waits twice as long before trying again. A listener that is no longer a socket will never accept again.
+      if (client == -1) {
+         if (errno == EBADF || errno == EINVAL || errno == ENOTSOCK) {
+            break;
+         }
+         if (errno != EINTR) {
+            acceptWait = acceptWait == 0 ? 1 : std::min(2 * acceptWait, LongestAcceptWait);
+            std::this_thread::sleep_for(std::chrono::milliseconds(acceptWait));
+         }
+         continue;
+      }
+      acceptWait = 0;
+
+      clients.emplace_back();
+      clients.back().done = std::make_unique<std::atomic<bool>>(false);
+      clients.back().socket = client;
+      clients.back().thread = std::thread([this, client, path, &clientsMutex, &shuttingDown, self = &clients.back()]() {
+         Graph::SearchScratch scratch;
+         std::string pending; //Bytes read that do not yet end in a newline.
+         char buffer[4096];
+         bool quit = false;
+         ssize_t received;
+
+         while (!quit && (received = read(client, buffer, sizeof(buffer))) > 0) {
+            //The client has sent more and has not said quit.
+
+            pending.append(buffer, static_cast<std::size_t>(received));
+            std::size_t newline;
+            while (!quit && (newline = pending.find('\n')) != std::string::npos) {
+               //A whole question is waiting.
+
+               std::string question = pending.substr(0, newline);
+               pending.erase(0, newline + 1);
+
+               //shutdown ends this client and stops the server taking new ones.
+               if (question == "shutdown" || question == "shutdown\r") {
+                  std::lock_guard<std::mutex> lock(clientsMutex);
+                  shuttingDown = true;
+                  quit = true;
+
+                  //Wake the accept call with a connection of our own, so the server loop sees shuttingDown.
+                  int wake = socket(AF_UNIX, SOCK_STREAM, 0);
+                  sockaddr_un self = {};
+                  self.sun_family = AF_UNIX;
+                  std::strncpy(self.sun_path, path, sizeof(self.sun_path) - 1);
+                  if (wake != -1) {
+                     connect(wake, reinterpret_cast<sockaddr*>(&self), sizeof(self));
+                     close(wake);
+                  }
+                  break;
+               }
+
+               std::string answer = Answer(question, scratch, quit);
+               for (std::size_t sent = 0; sent < answer.size();) {
+                  //The answer has not all been sent.
+
+                  ssize_t written = send(client, answer.data() + sent, answer.size() - sent, SendFlags);
+                  if (written <= 0) {
+                     quit = true;
+                     break;
+                  }
+                  sent += static_cast<std::size_t>(written);
+               }
+            }
+         }
+         {
+            std::lock_guard<std::mutex> lock(clientsMutex);
+            self->socket = -1;
+         }
+         close(client);
+         self->done->store(true);
+      });
+   }
+
+   //Clients still connected may be waiting in read for a question that never comes, so each connection is shut down
+   //to end their reads before their threads are joined.
+   {
+      std::lock_guard<std::mutex> lock(clientsMutex);
+      shuttingDown = true;
+      for (SocketClient& i : clients) {
+         //Every client has not been hung up on yet.
+
+         if (i.socket != -1) {
+            shutdown(i.socket, SHUT_RDWR);
+         }
+      }
+   }
+   for (SocketClient& i : clients) {
+      //Every client thread has not been joined yet.
+
+      i.thread.join();
+   }
+   close(listener);
+   unlink(path);
+   return true;
+#endif
+}
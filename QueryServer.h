@@ -0,0 +1,103 @@
+/*
+File Name:  QueryServer.h
+Author:     Logan Petersen
+Date:       Febuary 2, 2020
+Purpose:    This is the header file for the QueryServer class containing QueryServer's interface.
+            A QueryServer answers repeated questions about one frozen Graph, read one per line
+            from a stream or from clients of a local socket. Each line is a command and its
+            arguments separated by tabs, since names hold spaces and commas:
+
+               distance<TAB>name<TAB>name   The separation between two actors/actresses.
+               path<TAB>name<TAB>name       The separation, then the chain of actors/actresses with
+                                            each shared movie on a tab indented line between them,
+                                            then "visited<TAB>" and the number of vertices searched.
+               center<TAB>name              Every actor/actress and their distance from name.
+               distances<TAB>name<TAB>names Each of the tab separated names after the first, with its
+                                            distance from the first, one per line.
+               find<TAB>text                Every actor/actress whose name starts with text, case ignored.
+               quit                         Ends the session.
+
+            A name is found as written if it can be, and otherwise by the one name that matches it
+            with case ignored, or that starts with it, so "bacon, kevin" finds "Bacon, Kevin (I)".
+            Every answer ends with an empty line. A question that cannot be answered is answered
+            with a line starting with "error". Two actors/actresses are joined with a bidirectional
+            search that stops as soon as the two sides meet. A distances question searches from its center
+            only until every name is found, and the server keeps the searches of the last centers asked
+            about in a DistanceCache, so asking about the same center again needs no search at all. Each
+            worker thread keeps its own search scratch, so questions are answered at the same time
+            without touching the Graph.
+*/
+
+#pragma once
+
+#include "Graph.h"
+#include "DistanceCache.h" //Grants the cache of searches the distances questions are answered from.
+#include <string> //Grants string, for questions and answers.
+
+class QueryServer {
+public:
+   /*
+   Purpose:          Construct the server for a Graph.
+   Parameters:       graph, the Graph questions are asked about. It must be frozen and must not change while served.
+                     workers, the number of questions answered at once.
+   Preconditions:    This specific QueryServer object has not been instantiated.
+   Postconditions:   QueryServer object has been instantiated, sharing the Graph's threads between its workers, with
+                     an empty DistanceCache.
+   Return value:     None.
+   Functions Called: Graph::ThreadCount(), to split the Graph's threads between the workers.
+   */
+   QueryServer(const Graph& graph, unsigned workers);
+
+   /*
+   Purpose:          Answer questions read from a stream until it ends or says quit.
+   Parameters:       in, the stream questions are read from.
+                     out, the stream answers are written to, in the order the questions were asked.
+   Preconditions:    A QueryServer object has been instantiated.
+   Postconditions:   Every question read has been answered and out has been flushed after each answer.
+   Return value:     None.
+   Functions Called: Answer(), which answers each question.
+   */
+   void Serve(std::istream& in, std::ostream& out);
+
+   /*
+   Purpose:          Answer questions from clients of a local socket until a client says shutdown.
+   Parameters:       path, the file system path the socket is created at.
+   Preconditions:    A QueryServer object has been instantiated.
+   Postconditions:   The socket has been removed. Each client was served by its own thread with its own scratch, which
+                     is joined once the client hangs up. Clients still connected once a client says shutdown are hung
+                     up on.
+   Return value:     False if the socket could not be created, or if this system has no local sockets, true otherwise.
+   Functions Called: Answer(), which answers each question.
+   */
+   bool ServeSocket(const char* path);
+
+   /*
+   Purpose:          Answer one question.
+   Parameters:       question, one line holding a command and its arguments.
+                     scratch, the search scratch of the thread answering.
+                     quit, set to true if the question asked to end the session.
+   Preconditions:    A QueryServer object has been instantiated.
+   Postconditions:   Nothing in the Graph changes, though a distances question may keep its search in the cache.
+   Return value:     The answer, ending with an empty line.
+   Functions Called: Resolve(), Graph::FindMatching(), Graph::FindPath(), Graph::NameOf(), Graph::TitleOf(),
+                     Graph::GenerateNumbers() and DistanceCache::Lookup().
+   */
+   std::string Answer(const std::string& question, Graph::SearchScratch& scratch, bool& quit) const;
+private:
+   /*
+   Purpose:          Find the actor/actress a question names. The name is looked up as written, then with case
+                     ignored, then as the start of a name, and the first of these to give exactly one match is used.
+   Parameters:       name, the name from the question.
+                     error, set to the error answer when no single actor/actress is found.
+   Preconditions:    A QueryServer object has been instantiated.
+   Postconditions:   Nothing in the Graph changes.
+   Return value:     The id of the actor/actress, or Graph::NoVertex if none or several match.
+   Functions Called: Graph::Find() and Graph::FindMatching().
+   */
+   std::uint32_t Resolve(const std::string& name, std::string& error) const;
+
+   const Graph& graph;       //The Graph questions are asked about.
+   unsigned workers;         //The number of questions answered at once.
+   unsigned searchThreads;   //The threads each search may use.
+   mutable DistanceCache cache; //The searches kept for distances questions, which answering a question may add to.
+};
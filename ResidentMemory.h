@@ -0,0 +1,49 @@
+/*
+File Name:  ResidentMemory.h
+Author:     Logan Petersen
+Date:       Febuary 2, 2020
+Purpose:    This is the header file for ResidentMemory, which reports how much of the program is
+            actually held in memory, as the system counts it. This includes everything the Graph
+            allocated and every page of the mapped file that has been read, and is what --memory
+            reports alongside the size of the frozen graph.
+*/
+
+#pragma once
+
+#include <cstddef> //Grants size_t for the number of bytes.
+#include <fstream> //Grants file reading, for reading the process status.
+#include <string>  //Grants string, for the lines of the process status.
+
+/*
+Purpose:          Find the resident memory of this process, now and at its highest.
+Parameters:       current, set to the bytes resident now.
+                  peak, set to the most bytes that have been resident at once.
+Preconditions:    None.
+Postconditions:   Nothing changes. Both are left at 0 when the system does not say.
+Return value:     True if the system reported both, which needs the /proc file system.
+Functions Called: None.
+*/
+inline bool ResidentMemory(std::size_t& current, std::size_t& peak) {
+
+   //Local Variables
+   std::ifstream status("/proc/self/status");
+   std::string line;
+   int found = 0;
+
+   current = 0;
+   peak = 0;
+   while (std::getline(status, line)) {
+      //The status has not ended.
+
+      //The status gives both in kilobytes.
+      if (line.compare(0, 6, "VmRSS:") == 0) {
+         current = std::stoull(line.substr(6)) * 1024;
+         found++;
+      }
+      else if (line.compare(0, 6, "VmHWM:") == 0) {
+         peak = std::stoull(line.substr(6)) * 1024;
+         found++;
+      }
+   }
+   return found == 2;
+}
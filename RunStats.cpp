@@ -0,0 +1,39 @@
+/*
+File Name:  RunStats.cpp
+Author:     Logan Petersen
+Date:       Febuary 2, 2020
+Purpose:    The purpose of this code is to be the function definitions for
+            the prototypes in RunStats.h.
+*/
+
+#include "RunStats.h"
+
+/*
+Purpose:          Write everything recorded as one JSON object.
+Parameters:       out, the stream it is written to.
+Preconditions:    None.
+Postconditions:   The object, followed by a newline, has been written to out.
+Return value:     None.
+Functions Called: None.
+*/
+void RunStats::Write(std::ostream& out) const {
+
+   //The names of phases and directions are fixed words in the program, so none of them need escaping.
+   out << "{\"phases\": [";
+   for (std::size_t i = 0; i < phases.size(); i++) {
+      //Every phase has not been written yet.
+
+      out << (i == 0 ? "" : ", ") << "{\"name\": \"" << phases[i].name << "\", \"seconds\": " << phases[i].seconds << '}';
+   }
+   out << "], \"bytesParsed\": " << bytesParsed << ", \"entriesParsed\": " << entriesParsed
+       << ", \"duplicateNames\": " << duplicateNames << ", \"duplicateTitles\": " << duplicateTitles
+       << ", \"vertices\": " << vertices << ", \"movies\": " << movies << ", \"edges\": " << edges << ", \"levels\": [";
+   for (std::size_t i = 0; i < levels.size(); i++) {
+      //Every level has not been written yet.
+
+      out << (i == 0 ? "" : ", ") << "{\"distance\": " << levels[i].distance << ", \"frontier\": " << levels[i].frontier
+          << ", \"edges\": " << levels[i].edges << ", \"direction\": \"" << levels[i].direction << "\", \"seconds\": "
+          << levels[i].seconds << '}';
+   }
+   out << "], \"residentBytes\": " << residentBytes << ", \"peakResidentBytes\": " << peakResidentBytes << "}\n";
+}
@@ -0,0 +1,109 @@
+/*
+File Name:  RunStats.h
+Author:     Logan Petersen
+Date:       Febuary 2, 2020
+Purpose:    This is the header file for RunStats, which records where a run's time went, and
+            PhaseTimer, which times one phase of it. A Graph given a RunStats with SetStats records
+            the phases it runs, how many duplicate names and movies it skipped, and each level of its
+            breadth first searches, and --stats prints it all as JSON once the run is done.
+
+            Building with NO_RUN_STATS defined removes the recording entirely: RunStatsBuilt is
+            false, so every check for a RunStats is decided when compiling and nothing is timed or
+            counted. Otherwise a run without --stats pays one check of a null pointer per actor/actress
+            added and per level searched.
+*/
+
+#pragma once
+
+#include <chrono>  //Grants steady_clock, which times the phases and levels.
+#include <cstdint> //Grants the fixed width integers the counts are kept in.
+#include <cstddef> //Grants size_t for the memory counts.
+#include <ostream> //Grants ostream, which the JSON is written to.
+#include <vector>  //Grants the vectors the phases and levels are kept in.
+
+#ifdef NO_RUN_STATS
+constexpr bool RunStatsBuilt = false; //True when the program records RunStats at all.
+#else
+constexpr bool RunStatsBuilt = true;  //True when the program records RunStats at all.
+#endif
+
+//Everything recorded about one run.
+struct RunStats {
+
+   //One timed phase of the run.
+   struct Phase {
+      const char* name;       //What the phase did.
+      double seconds;         //How long it took.
+   };
+
+   //One level of a breadth first search.
+   struct Level {
+      int distance;           //The distance of the frontier this level expanded.
+      std::uint64_t frontier; //The number of actors/actresses in that frontier.
+      std::uint64_t edges;    //The edges out of the frontier, or its credits in a bipartite Graph.
+      const char* direction;  //How the level was expanded: top-down, bottom-up or by movie.
+      double seconds;         //How long it took to expand, not counting what was done with the level found.
+   };
+
+   std::vector<Phase> phases;       //Every phase, in the order it ended.
+   std::uint64_t bytesParsed = 0;   //The bytes of actors list parsed.
+   std::uint64_t entriesParsed = 0; //The actor/actress entries found in them.
+   std::uint64_t duplicateNames = 0; //Entries skipped because their name was already in the Graph.
+   std::uint64_t duplicateTitles = 0; //Credits skipped because the entry listed the movie already.
+   std::uint64_t vertices = 0;      //The actors/actresses in the Graph.
+   std::uint64_t movies = 0;        //The movies in the Graph.
+   std::uint64_t edges = 0;         //The edges of the frozen graph.
+   std::vector<Level> levels;       //Every level of every search, in the order they were expanded.
+   std::size_t residentBytes = 0;   //The resident memory when the run ended.
+   std::size_t peakResidentBytes = 0; //The most resident memory during the run.
+
+   /*
+   Purpose:          Write everything recorded as one JSON object.
+   Parameters:       out, the stream it is written to.
+   Preconditions:    None.
+   Postconditions:   The object, followed by a newline, has been written to out.
+   Return value:     None.
+   Functions Called: None.
+   */
+   void Write(std::ostream& out) const;
+};
+
+//Times a phase from its construction until it leaves scope, and adds it to a RunStats.
+class PhaseTimer {
+public:
+   /*
+   Purpose:          Start timing a phase.
+   Parameters:       stats, the RunStats the phase is added to, or nullptr to time nothing.
+                     name, what the phase does. It must outlive stats.
+   Preconditions:    This specific PhaseTimer object has not been instantiated.
+   Postconditions:   The phase is being timed if stats is not nullptr and RunStats are built.
+   Return value:     None.
+   Functions Called: None.
+   */
+   PhaseTimer(RunStats* stats, const char* name) : stats(stats), name(name) {
+      if (RunStatsBuilt && stats != nullptr) {
+         start = std::chrono::steady_clock::now();
+      }
+   }
+
+   /*
+   Purpose:          Stop timing the phase.
+   Parameters:       None.
+   Preconditions:    This specific PhaseTimer object has left scope.
+   Postconditions:   The phase has been added to the RunStats, if one was given.
+   Return value:     None.
+   Functions Called: None.
+   */
+   ~PhaseTimer() {
+      if (RunStatsBuilt && stats != nullptr) {
+         stats->phases.push_back({name, std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count()});
+      }
+   }
+
+   PhaseTimer(const PhaseTimer&) = delete;
+   PhaseTimer& operator=(const PhaseTimer&) = delete;
+private:
+   RunStats* stats;                              //Where the phase is added, or nullptr.
+   const char* name;                             //What the phase does.
+   std::chrono::steady_clock::time_point start;  //When the phase began.
+};
@@ -0,0 +1,254 @@
+/*
+File Name:  SortedOutput.cpp
+Author:     Logan Petersen
+Date:       Febuary 2, 2020
+Purpose:    The purpose of this code is to be the function definitions for
+            the prototypes in SortedOutput.h, along with the radix sort they
+            are printed in the order of.
+*/
+
+#include "SortedOutput.h"
+#include "Parallel.h" //Grants ParallelFor, which splits each pass of the sort across the threads.
+#include <algorithm>  //Grants sort, for the rows whose keys are equal, and max.
+#include <cstddef>    //Grants size_t for the counts of each bucket.
+
+namespace {
+
+   //One printed row while it is sorted.
+   struct Row {
+      std::uint64_t key;      //The first 8 bytes of the name in the order first name last name, the first byte highest.
+      std::uint32_t id;       //The id of the actor/actress.
+      std::uint32_t distance; //The distance, with those who cannot be reached given one more than the largest.
+   };
+
+   /*
+   Purpose:          Move every row to where its bucket places it, keeping the order of rows in the same bucket. Each
+                     block of rows is counted on its own thread, and then moves its rows to the places its counts give.
+   Parameters:       from, the rows in their order so far.
+                     to, the rows in the order of their buckets. It has as many rows as from.
+                     buckets, the number of buckets.
+                     bucketOf, gives the bucket of a row, less than buckets.
+                     threads, the number of threads used.
+   Preconditions:    None.
+   Postconditions:   Nothing changes if every row is in the same bucket.
+   Return value:     True if the rows were moved into to, false if they were all in one bucket and left in from.
+   Functions Called: ParallelFor(), which splits the rows into blocks.
+   */
+   template <typename BucketOf>
+   bool CountingPass(const std::vector<Row>& from, std::vector<Row>& to, std::size_t buckets, BucketOf bucketOf,
+                     unsigned threads) {
+
+      //Local Variables
+      std::size_t blocks = threads == 0 ? 1 : threads;
+      std::vector<std::size_t> counts(blocks * buckets, 0); //counts[block * buckets + bucket], then where it moves to.
+      std::size_t next = 0;
+
+      ParallelFor(from.size(), threads, [&from, &counts, buckets, &bucketOf](std::size_t begin, std::size_t end, std::size_t block) {
+         std::size_t* blockCounts = counts.data() + block * buckets;
+
+         for (std::size_t i = begin; i < end; i++) {
+            //Every row of this block has not been counted yet.
+
+            blockCounts[bucketOf(from[i])]++;
+         }
+      });
+
+      //A bucket's rows go after every earlier bucket's, and within it each block's go after every earlier block's.
+      for (std::size_t bucket = 0; bucket < buckets; bucket++) {
+         //Every bucket has not been placed yet.
+
+         std::size_t total = 0;
+         for (std::size_t block = 0; block < blocks; block++) {
+            //Every block's share of this bucket has not been placed yet.
+
+            std::size_t count = counts[block * buckets + bucket];
+            counts[block * buckets + bucket] = next + total;
+            total += count;
+         }
+         if (total == from.size()) {
+            return false;
+         }
+         next += total;
+      }
+
+      ParallelFor(from.size(), threads, [&from, &to, &counts, buckets, &bucketOf](std::size_t begin, std::size_t end, std::size_t block) {
+         std::size_t* blockNext = counts.data() + block * buckets;
+
+         for (std::size_t i = begin; i < end; i++) {
+            //Every row of this block has not been moved yet.
+
+            to[blockNext[bucketOf(from[i])]++] = from[i];
+         }
+      });
+      return true;
+   }
+}
+
+/*
+Purpose:          Add a name as it appears in the actors list, last name first, to a string in the order first name
+                  last name. The numeral in parentheses that tells apart actors/actresses of the same name stays at
+                  the end, so "Bacon, Kevin (I)" becomes "Kevin Bacon (I)". A name without a comma is kept as it is.
+Parameters:       name, the name as it appears in the actors list.
+                  out, the string the name is added to.
+Preconditions:    None.
+Postconditions:   The name has been added to the end of out.
+Return value:     None.
+Functions Called: None.
+*/
+void AppendFirstLast(std::string_view name, std::string& out) {
+
+   //Local Variables
+   std::size_t comma = name.find(", ");
+   std::size_t suffix = name.size(); //Where the numeral in parentheses starts, or the end of the name.
+   std::string_view first;
+
+   if (comma == std::string_view::npos) {
+      out.append(name);
+      return;
+   }
+   if (name.back() == ')') {
+      std::size_t open = name.rfind(" (");
+      if (open != std::string_view::npos && open > comma) {
+         suffix = open;
+      }
+   }
+   first = name.substr(comma + 2, suffix - comma - 2);
+   if (!first.empty()) {
+      out.append(first);
+      out.push_back(' ');
+   }
+   out.append(name.substr(0, comma));
+   out.append(name.substr(suffix));
+}
+
+/*
+Purpose:          Print actors/actresses and their distances sorted by distance and then by name in the order first
+                  name last name, each on its own line as the name, a tab and the distance, or infinity for those
+                  who cannot be reached, who come last.
+Parameters:       ids, the ids of the actors/actresses printed.
+                  distances, the distance of every id, or -1 if it cannot be reached.
+                  nameOf, gives the name of an id as it appears in the actors list.
+                  threads, the number of threads the sort uses.
+                  out, the writer the lines are printed through.
+Preconditions:    Every id indexes distances, and nameOf may be called from several threads at once.
+Postconditions:   Every line has been given to out.
+Return value:     None.
+Functions Called: AppendFirstLast(), which turns each name around, and ParallelFor(), which splits the sort across
+                  the threads.
+*/
+void WriteSorted(const std::vector<std::uint32_t>& ids, const std::vector<int>& distances,
+                 const std::function<std::string_view(std::uint32_t)>& nameOf, unsigned threads, OutputWriter& out) {
+
+   //Local Variables
+   std::vector<Row> rows(ids.size());
+   std::vector<Row> moved(ids.size()); //Where each pass moves the rows to, before the two are swapped.
+   std::vector<std::size_t> blockLargest(threads == 0 ? 1 : threads, 0);
+   std::uint32_t unreached = 0;        //The distance given to those who cannot be reached.
+   std::vector<std::size_t> runs;      //Where each run of rows with the same distance and key starts, and the end.
+   std::string name;
+
+   ParallelFor(ids.size(), threads, [&ids, &distances, &nameOf, &rows, &blockLargest](std::size_t begin, std::size_t end, std::size_t block) {
+      std::string firstLast;
+
+      for (std::size_t i = begin; i < end; i++) {
+         //Every row of this block has not been keyed yet.
+
+         std::uint64_t key = 0;
+         firstLast.clear();
+         AppendFirstLast(nameOf(ids[i]), firstLast);
+         for (std::size_t byte = 0; byte < 8; byte++) {
+            //Every byte of the key has not been filled in yet. Names shorter than 8 bytes are padded with zeros,
+            //so they come before every longer name they start.
+
+            key = key << 8 | (byte < firstLast.size() ? static_cast<unsigned char>(firstLast[byte]) : 0);
+         }
+         rows[i] = {key, ids[i], static_cast<std::uint32_t>(distances[ids[i]])};
+         if (distances[ids[i]] >= 0) {
+            blockLargest[block] = std::max<std::size_t>(blockLargest[block], distances[ids[i]] + 1);
+         }
+      }
+   });
+   for (std::size_t i : blockLargest) {
+      //Every block's largest distance has not been looked at yet.
+
+      unreached = std::max(unreached, static_cast<std::uint32_t>(i));
+   }
+   for (Row& row : rows) {
+      //Every row's distance has not been checked yet.
+
+      if (row.distance == static_cast<std::uint32_t>(-1)) {
+         row.distance = unreached;
+      }
+   }
+
+   //The key's bytes are sorted from the lowest up, and the distance last, so each pass keeps the order the passes
+   //before it left among the rows it does not tell apart.
+   for (int shift = 0; shift < 64; shift += 8) {
+      //Every byte of the key has not been sorted by yet.
+
+      if (CountingPass(rows, moved, 256, [shift](const Row& row) { return (row.key >> shift) & 0xFF; }, threads)) {
+         rows.swap(moved);
+      }
+   }
+   if (CountingPass(rows, moved, unreached + 1, [](const Row& row) { return row.distance; }, threads)) {
+      rows.swap(moved);
+   }
+
+   //Rows whose distance and first 8 bytes are the same are sorted by their whole names. Names are unique, so
+   //this decides the order of every row.
+   for (std::size_t i = 0; i < rows.size(); i++) {
+      //Every row has not been checked for the start of a run yet.
+
+      if (i == 0 || rows[i].distance != rows[i - 1].distance || rows[i].key != rows[i - 1].key) {
+         runs.push_back(i);
+      }
+   }
+   runs.push_back(rows.size());
+   ParallelFor(runs.size() - 1, threads, [&runs, &rows, &nameOf](std::size_t begin, std::size_t end, std::size_t) {
+      std::vector<std::pair<std::string, std::uint32_t>> names; //Each row of the run's name, first name first, and its id.
+
+      for (std::size_t run = begin; run < end; run++) {
+         //Every run of this block has not been sorted yet.
+
+         if (runs[run + 1] - runs[run] < 2) {
+            continue;
+         }
+         names.clear();
+         for (std::size_t i = runs[run]; i < runs[run + 1]; i++) {
+            //Every row of the run has not been named yet.
+
+            names.emplace_back(std::string(), rows[i].id);
+            AppendFirstLast(nameOf(rows[i].id), names.back().first);
+         }
+
+         //Two names can only turn around into the same one if one of them has no comma, so the names as they appear
+         //in the actors list settle it.
+         std::sort(names.begin(), names.end(), [&nameOf](const std::pair<std::string, std::uint32_t>& first,
+                                                         const std::pair<std::string, std::uint32_t>& second) {
+            int compared = first.first.compare(second.first);
+            return compared != 0 ? compared < 0 : nameOf(first.second) < nameOf(second.second);
+         });
+         for (std::size_t i = runs[run]; i < runs[run + 1]; i++) {
+            //Every row of the run has not been put in its place yet.
+
+            rows[i].id = names[i - runs[run]].second;
+         }
+      }
+   });
+
+   for (const Row& row : rows) {
+      //Every row has not been printed yet.
+
+      name.clear();
+      AppendFirstLast(nameOf(row.id), name);
+      out.Write(name);
+      if (row.distance == unreached) {
+         out.Write("\tinfinity\n");
+      }
+      else {
+         out.Write('\t');
+         out.WriteNumber(row.distance);
+         out.Write('\n');
+      }
+   }
+}
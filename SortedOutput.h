@@ -0,0 +1,56 @@
+/*
+File Name:  SortedOutput.h
+Author:     Logan Petersen
+Date:       Febuary 2, 2020
+Purpose:    This is the header file for the sorted output, which --sorted prints the Bacon Numbers in.
+            Every actor/actress is printed with their name in the order first name last name, sorted by
+            distance and then by that name, with those who cannot be reached last. The order depends on
+            nothing but the names and distances, so it is the same whatever order the actors list is
+            in, however many threads are used and whatever --order numbers the vertices, and two runs
+            over lists that differ a little give output that differs only where they do.
+
+            The rows are sorted with a parallel radix sort. Each row's key is its distance and the first
+            8 bytes of its name, and each pass counts one byte of the key in every block of rows at once
+            before the blocks move their rows to where the counts place them. Rows whose keys are equal
+            are then sorted by their whole names, each run of them on its own.
+*/
+
+#pragma once
+
+#include "OutputWriter.h" //Grants OutputWriter, which the rows are printed through.
+#include <cstdint>        //Grants the fixed width integers the ids and keys are kept in.
+#include <functional>     //Grants function, which gives each row's name.
+#include <string>         //Grants string, which a name is turned around into.
+#include <string_view>    //Grants string_view, which names are given as.
+#include <vector>         //Grants the vectors of ids and distances.
+
+/*
+Purpose:          Add a name as it appears in the actors list, last name first, to a string in the order first name
+                  last name. The numeral in parentheses that tells apart actors/actresses of the same name stays at
+                  the end, so "Bacon, Kevin (I)" becomes "Kevin Bacon (I)". A name without a comma is kept as it is.
+Parameters:       name, the name as it appears in the actors list.
+                  out, the string the name is added to.
+Preconditions:    None.
+Postconditions:   The name has been added to the end of out.
+Return value:     None.
+Functions Called: None.
+*/
+void AppendFirstLast(std::string_view name, std::string& out);
+
+/*
+Purpose:          Print actors/actresses and their distances sorted by distance and then by name in the order first
+                  name last name, each on its own line as the name, a tab and the distance, or infinity for those
+                  who cannot be reached, who come last.
+Parameters:       ids, the ids of the actors/actresses printed.
+                  distances, the distance of every id, or -1 if it cannot be reached.
+                  nameOf, gives the name of an id as it appears in the actors list.
+                  threads, the number of threads the sort uses.
+                  out, the writer the lines are printed through.
+Preconditions:    Every id indexes distances, and nameOf may be called from several threads at once.
+Postconditions:   Every line has been given to out.
+Return value:     None.
+Functions Called: AppendFirstLast(), which turns each name around, and ParallelFor(), which splits the sort across
+                  the threads.
+*/
+void WriteSorted(const std::vector<std::uint32_t>& ids, const std::vector<int>& distances,
+                 const std::function<std::string_view(std::uint32_t)>& nameOf, unsigned threads, OutputWriter& out);
@@ -0,0 +1,240 @@
+/*
+File Name:  StringArena.cpp
+Author:     Logan Petersen
+Date:       Febuary 2, 2020
+Purpose:    The purpose of this code is to be the function definitions for
+            the prototypes in StringArena.h. New strings are appended to the
+            end of one buffer, so storing a string costs its bytes and one offset
+            rather than an allocation of its own.
+*/
+
+#include "StringArena.h"
+#include <algorithm> //Grants max, for the smallest hash table.
+
+/*
+Purpose:          Construct the StringArena when it is created without arguments.
+Parameters:       None.
+Preconditions:    This specific StringArena object has not been instantiated.
+Postconditions:   StringArena object has been instantiated holding no strings.
+Return value:     None.
+Functions Called: Clear(), which sets up the empty tables.
+*/
+StringArena::StringArena() {
+   Clear();
+}
+
+/*
+Purpose:          Give the id of a string, storing it first if it is not already in the arena.
+Parameters:       text, the string.
+                  added, set to true if text was new to the arena, false if it was already there.
+Preconditions:    The arena owns its tables, rather than reading them from a mapping.
+Postconditions:   text is in the arena. Views given out before may no longer be valid if it was added.
+Return value:     The id of text. Ids are given out in order, starting from 0.
+Functions Called: Find(), which looks for text first, and Place(), which puts a new id into the hash table.
+*/
+std::uint32_t StringArena::Intern(std::string_view text, bool& added) {
+
+   //Local Variables
+   std::uint32_t id = Find(text);
+
+   added = id == NoString;
+   if (!added) {
+      return id;
+   }
+   id = static_cast<std::uint32_t>(Size());
+   byteStorage.insert(byteStorage.end(), text.begin(), text.end());
+   offsetStorage.push_back(byteStorage.size());
+   offsets = offsetStorage;
+   bytes = byteStorage;
+   Place(id);
+   return id;
+}
+
+/*
+Purpose:          Find the id of a string.
+Parameters:       text, the string.
+Preconditions:    A StringArena object has been instantiated.
+Postconditions:   Nothing in the arena changes.
+Return value:     The id of text, or NoString if it is not in the arena.
+Functions Called: None.
+*/
+std::uint32_t StringArena::Find(std::string_view text) const {
+
+   //Local Variables
+   std::size_t mask;
+
+   if (slots.empty()) {
+      return NoString;
+   }
+   mask = slots.size() - 1;
+   for (std::size_t slot = Hash(text) & mask; slots[slot] != NoString; slot = (slot + 1) & mask) {
+      //The run of full slots the string would be in has not ended.
+
+      if (Get(slots[slot]) == text) {
+         return slots[slot];
+      }
+   }
+   return NoString;
+}
+
+/*
+Purpose:          Give a string by its id.
+Parameters:       id, the id of the string.
+Preconditions:    id is less than Size().
+Postconditions:   Nothing in the arena changes.
+Return value:     The string, which stays valid until a string is next added or the arena is cleared.
+Functions Called: None.
+*/
+std::string_view StringArena::Get(std::uint32_t id) const {
+   return std::string_view(bytes.begin() + offsets[id], static_cast<std::size_t>(offsets[id + 1] - offsets[id]));
+}
+
+/*
+Purpose:          Give the number of strings in the arena.
+Parameters:       None.
+Preconditions:    A StringArena object has been instantiated.
+Postconditions:   Nothing in the arena changes.
+Return value:     The number of strings, which is one more than the largest id.
+Functions Called: None.
+*/
+std::size_t StringArena::Size() const {
+   return offsets.size() - 1;
+}
+
+/*
+Purpose:          Read the arena from tables that live elsewhere, such as in a mapped snapshot.
+Parameters:       newOffsets, where each string starts in newBytes, with one extra entry at the end.
+                  newBytes, every string, one after another.
+                  newSlots, the hash table, as given by Slots() when the tables were saved.
+Preconditions:    The tables stay valid for as long as the arena reads them.
+Postconditions:   The arena holds the strings of the tables, and owns nothing.
+Return value:     None.
+Functions Called: None.
+*/
+void StringArena::Map(ArrayView<std::uint64_t> newOffsets, ArrayView<char> newBytes, ArrayView<std::uint32_t> newSlots) {
+   std::vector<std::uint64_t>().swap(offsetStorage);
+   std::vector<char>().swap(byteStorage);
+   std::vector<std::uint32_t>().swap(slotStorage);
+   offsets = newOffsets;
+   bytes = newBytes;
+   slots = newSlots;
+}
+
+/*
+Purpose:          Copy tables the arena reads from elsewhere into tables of its own.
+Parameters:       None.
+Preconditions:    A StringArena object has been instantiated.
+Postconditions:   The arena owns its tables and no longer needs the ones given to Map.
+Return value:     None.
+Functions Called: None.
+*/
+void StringArena::Own() {
+   if (offsets.begin() == offsetStorage.data()) {
+      return;
+   }
+   offsetStorage.assign(offsets.begin(), offsets.end());
+   byteStorage.assign(bytes.begin(), bytes.end());
+   slotStorage.assign(slots.begin(), slots.end());
+   offsets = offsetStorage;
+   bytes = byteStorage;
+   slots = slotStorage;
+}
+
+/*
+Purpose:          Remove every string.
+Parameters:       None.
+Preconditions:    A StringArena object has been instantiated.
+Postconditions:   The arena owns empty tables, and their memory has been released.
+Return value:     None.
+Functions Called: None.
+*/
+void StringArena::Clear() {
+   std::vector<std::uint64_t>(1, 0).swap(offsetStorage);
+   std::vector<char>().swap(byteStorage);
+   std::vector<std::uint32_t>().swap(slotStorage);
+   offsets = offsetStorage;
+   bytes = byteStorage;
+   slots = slotStorage;
+}
+
+/*
+Purpose:          Give the tables, so they can be saved and later read back with Map.
+Parameters:       None.
+Preconditions:    A StringArena object has been instantiated.
+Postconditions:   Nothing in the arena changes.
+Return value:     The offsets, the bytes and the hash table. The hash table is a power of two in size.
+Functions Called: None.
+*/
+ArrayView<std::uint64_t> StringArena::Offsets() const {
+   return offsets;
+}
+
+ArrayView<char> StringArena::Bytes() const {
+   return bytes;
+}
+
+ArrayView<std::uint32_t> StringArena::Slots() const {
+   return slots;
+}
+
+/*
+Purpose:          Hash a string. The hash is written out rather than taken from std::hash so that a hash table
+                  saved in a snapshot is read back the same by every build.
+Parameters:       text, the string to hash.
+Preconditions:    None.
+Postconditions:   Nothing changes.
+Return value:     The 64 bit FNV-1a hash of the string.
+Functions Called: None.
+*/
+std::uint64_t StringArena::Hash(std::string_view text) {
+   std::uint64_t hash = 0xcbf29ce484222325;
+
+   for (char i : text) {
+      //Every character of the string has not been hashed yet.
+
+      hash = (hash ^ static_cast<unsigned char>(i)) * 0x100000001b3;
+   }
+   return hash;
+}
+
+/*
+Purpose:          Put an id into the hash table, doubling the table first if it would be over half full.
+Parameters:       id, the id of the newest string.
+Preconditions:    Every id before id is in the table.
+Postconditions:   Find(Get(id)) gives id.
+Return value:     None.
+Functions Called: Hash(), which gives where the search for a slot starts.
+*/
+void StringArena::Place(std::uint32_t id) {
+
+   //Local Variables
+   std::size_t size = std::max<std::size_t>(slotStorage.size(), 16);
+   auto place = [this](std::uint32_t string) {
+      std::size_t mask = slotStorage.size() - 1;
+      std::size_t slot = Hash(Get(string)) & mask;
+
+      while (slotStorage[slot] != NoString) {
+         //This slot is taken.
+
+         slot = (slot + 1) & mask;
+      }
+      slotStorage[slot] = string;
+   };
+
+   //Keeping the table at most half full keeps the runs of full slots short.
+   while (size < 2 * (static_cast<std::size_t>(id) + 1)) {
+      //The table would be over half full.
+
+      size *= 2;
+   }
+   if (size != slotStorage.size()) {
+      slotStorage.assign(size, NoString);
+      for (std::uint32_t i = 0; i < id; i++) {
+         //Every older string has not been put into the bigger table yet.
+
+         place(i);
+      }
+   }
+   place(id);
+   slots = slotStorage;
+}
@@ -0,0 +1,151 @@
+/*
+File Name:  StringArena.h
+Author:     Logan Petersen
+Date:       Febuary 2, 2020
+Purpose:    This is the header file for the StringArena class containing StringArena's interface.
+            A StringArena interns strings: each distinct string is stored once, one after another
+            in a single buffer, and is known by a 32 bit id from then on. A hash table of ids finds
+            the id of a string without comparing it against every other. The three tables are
+            read through ArrayViews, so an arena can equally be read from a mapped snapshot.
+*/
+
+#pragma once
+
+#include <cstdint>     //Grants the fixed width integers ids and offsets are made of.
+#include <cstddef>     //Grants size_t for sizes of the tables.
+#include <string_view> //Grants string_view, which is how strings go in and come out.
+#include <vector>      //Grants the vectors the tables are kept in when the arena owns them.
+#include "ArrayView.h" //Grants ArrayView, through which the tables are read wherever they live.
+
+class StringArena {
+public:
+   static constexpr std::uint32_t NoString = 0xFFFFFFFF; //The id given when there is no such string.
+
+   /*
+   Purpose:          Construct the StringArena when it is created without arguments.
+   Parameters:       None.
+   Preconditions:    This specific StringArena object has not been instantiated.
+   Postconditions:   StringArena object has been instantiated holding no strings.
+   Return value:     None.
+   Functions Called: Clear(), which sets up the empty tables.
+   */
+   StringArena();
+
+   //The views would go on looking at the other arena's tables.
+   StringArena(const StringArena&) = delete;
+   StringArena& operator=(const StringArena&) = delete;
+
+   /*
+   Purpose:          Give the id of a string, storing it first if it is not already in the arena.
+   Parameters:       text, the string.
+                     added, set to true if text was new to the arena, false if it was already there.
+   Preconditions:    The arena owns its tables, rather than reading them from a mapping.
+   Postconditions:   text is in the arena. Views given out before may no longer be valid if it was added.
+   Return value:     The id of text. Ids are given out in order, starting from 0.
+   Functions Called: Find(), which looks for text first, and Place(), which puts a new id into the hash table.
+   */
+   std::uint32_t Intern(std::string_view text, bool& added);
+
+   /*
+   Purpose:          Find the id of a string.
+   Parameters:       text, the string.
+   Preconditions:    A StringArena object has been instantiated.
+   Postconditions:   Nothing in the arena changes.
+   Return value:     The id of text, or NoString if it is not in the arena.
+   Functions Called: None.
+   */
+   std::uint32_t Find(std::string_view text) const;
+
+   /*
+   Purpose:          Give a string by its id.
+   Parameters:       id, the id of the string.
+   Preconditions:    id is less than Size().
+   Postconditions:   Nothing in the arena changes.
+   Return value:     The string, which stays valid until a string is next added or the arena is cleared.
+   Functions Called: None.
+   */
+   std::string_view Get(std::uint32_t id) const;
+
+   /*
+   Purpose:          Give the number of strings in the arena.
+   Parameters:       None.
+   Preconditions:    A StringArena object has been instantiated.
+   Postconditions:   Nothing in the arena changes.
+   Return value:     The number of strings, which is one more than the largest id.
+   Functions Called: None.
+   */
+   std::size_t Size() const;
+
+   /*
+   Purpose:          Read the arena from tables that live elsewhere, such as in a mapped snapshot.
+   Parameters:       newOffsets, where each string starts in newBytes, with one extra entry at the end.
+                     newBytes, every string, one after another.
+                     newSlots, the hash table, as given by Slots() when the tables were saved.
+   Preconditions:    The tables stay valid for as long as the arena reads them.
+   Postconditions:   The arena holds the strings of the tables, and owns nothing.
+   Return value:     None.
+   Functions Called: None.
+   */
+   void Map(ArrayView<std::uint64_t> newOffsets, ArrayView<char> newBytes, ArrayView<std::uint32_t> newSlots);
+
+   /*
+   Purpose:          Copy tables the arena reads from elsewhere into tables of its own.
+   Parameters:       None.
+   Preconditions:    A StringArena object has been instantiated.
+   Postconditions:   The arena owns its tables and no longer needs the ones given to Map.
+   Return value:     None.
+   Functions Called: None.
+   */
+   void Own();
+
+   /*
+   Purpose:          Remove every string.
+   Parameters:       None.
+   Preconditions:    A StringArena object has been instantiated.
+   Postconditions:   The arena owns empty tables, and their memory has been released.
+   Return value:     None.
+   Functions Called: None.
+   */
+   void Clear();
+
+   /*
+   Purpose:          Give the tables, so they can be saved and later read back with Map.
+   Parameters:       None.
+   Preconditions:    A StringArena object has been instantiated.
+   Postconditions:   Nothing in the arena changes.
+   Return value:     The offsets, the bytes and the hash table. The hash table is a power of two in size.
+   Functions Called: None.
+   */
+   ArrayView<std::uint64_t> Offsets() const;
+   ArrayView<char> Bytes() const;
+   ArrayView<std::uint32_t> Slots() const;
+
+   /*
+   Purpose:          Hash a string. The hash is written out rather than taken from std::hash so that a hash table
+                     saved in a snapshot is read back the same by every build.
+   Parameters:       text, the string to hash.
+   Preconditions:    None.
+   Postconditions:   Nothing changes.
+   Return value:     The 64 bit FNV-1a hash of the string.
+   Functions Called: None.
+   */
+   static std::uint64_t Hash(std::string_view text);
+private:
+   /*
+   Purpose:          Put an id into the hash table, doubling the table first if it would be over half full.
+   Parameters:       id, the id of the newest string.
+   Preconditions:    Every id before id is in the table.
+   Postconditions:   Find(Get(id)) gives id.
+   Return value:     None.
+   Functions Called: Hash(), which gives where the search for a slot starts.
+   */
+   void Place(std::uint32_t id);
+
+   ArrayView<std::uint64_t> offsets;        //Where each string starts in bytes, with one extra entry at the end.
+   ArrayView<char> bytes;                   //Every string, one after another, in the order of their ids.
+   ArrayView<std::uint32_t> slots;          //A hash table of ids with linear probing, at most half full. An empty slot
+                                            //holds NoString.
+   std::vector<std::uint64_t> offsetStorage; //The offsets when the arena owns them.
+   std::vector<char> byteStorage;            //The bytes when the arena owns them.
+   std::vector<std::uint32_t> slotStorage;   //The hash table when the arena owns it.
+};
@@ -0,0 +1,281 @@
+/*
+File Name:  Benchmark.cpp
+Author:     Logan Petersen
+Date:       Febuary 2, 2020
+Purpose:    The purpose of this code is to measure each stage of KevinBaconGame on an actors list,
+            such as one written by GenerateActorList, so that a change that slows a stage down can
+            be caught. It is built on its own, from the top of the repository, with every source
+            file but KevinBaconGame.cpp:
+
+               g++ -std=c++17 -O2 -pthread -o Benchmark benchmarks/Benchmark.cpp $(ls *.cpp | grep -v KevinBaconGame) -lz
+
+            leaving out -lz if -DNO_ZLIB is given instead, and run as
+
+               Benchmark PATH [--threads N] [--repeat N] [--bipartite] [--center NAME] [--order NAME] [--compress] [--sorted]
+
+            Each stage is reported on its own line as its name, the seconds it took and its rate,
+            separated by tabs, so runs can be compared with diff or a spreadsheet:
+
+               parse     the parsers alone over the file, in megabytes of the file a second
+               load      parsing and adding every actor/actress to the Graph, in megabytes a second
+               build     freezing the Graph, in edges of the frozen graph a second
+               search    one breadth first search from the center, in edges of the frozen graph a second,
+                         taking the fastest of --repeat searches
+               print     printing every distance from the center, in megabytes of output a second
+               memory    the resident memory once the Graph is frozen and at its highest, in megabytes
+               rows      the memory the frozen rows take, in megabytes, and their bytes for each edge
+
+            --threads, --bipartite, --center, --order, --compress and --sorted work as they do for
+            KevinBaconGame, so with --sorted the print line times sorting the distances as well.
+            --order all freezes and searches the Graph in each order in turn, giving build, search and
+            print lines for each, with each search's speedup over the file order.
+
+            Key variables are graph, the Graph object, and the settings read from the arguments.
+*/
+
+#include "../Graph.h"
+#include "../MappedFile.h"      //Grants the mapping of the actors list into memory.
+#include "../ActorListLoader.h" //Grants the loader, and SplitActorList for parsing alone.
+#include "../ActorListParser.h" //Grants the parser, timed on its own.
+#include "../Parallel.h"        //Grants ParallelFor and DefaultThreadCount.
+#include "../ResidentMemory.h"  //Grants ResidentMemory, for the memory line.
+#include <chrono>               //Grants steady_clock, which times each stage.
+#include <streambuf>            //Grants streambuf, which the printed distances are counted by and dropped into.
+#include <algorithm>            //Grants min and max, for the fastest search and the thread count.
+#include <cstdlib>              //Grants atoi, for reading the numbers given.
+
+namespace {
+
+   //A stream buffer that counts what is written to it and keeps none of it, so printing can be timed without
+   //timing a terminal or a disk.
+   class CountingBuffer : public std::streambuf {
+   public:
+      std::size_t count = 0; //The number of characters written.
+   protected:
+      std::streamsize xsputn(const char*, std::streamsize size) override {
+         count += static_cast<std::size_t>(size);
+         return size;
+      }
+
+      int_type overflow(int_type character) override {
+         count++;
+         return character;
+      }
+   };
+
+   /*
+   Purpose:          Give the seconds since a time.
+   Parameters:       start, the time.
+   Preconditions:    None.
+   Postconditions:   Nothing changes.
+   Return value:     The seconds from start until now.
+   Functions Called: None.
+   */
+   double SecondsSince(std::chrono::steady_clock::time_point start) {
+      return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+   }
+
+   /*
+   Purpose:          Print one stage's line.
+   Parameters:       stage, the name of the stage.
+                     seconds, how long it took.
+                     rate, how much it did each second.
+                     unit, what rate counts.
+   Preconditions:    None.
+   Postconditions:   The line has been printed to cout.
+   Return value:     None.
+   Functions Called: None.
+   */
+   void Report(const char* stage, double seconds, double rate, const char* unit) {
+      std::cout << stage << '\t' << seconds << " s\t" << rate << ' ' << unit << '\n';
+   }
+}
+
+int main(int argc, char** argv) {
+
+   //Local Variables
+   Graph graph;
+   Graph::SearchScratch scratch;
+   MappedFile parseFile;                        //The copy of the file the parsers alone are timed on.
+   MappedFile file;                             //The copy of the file the Graph is loaded from.
+   unsigned threadCount = DefaultThreadCount(); //Set by --threads, the number of threads used.
+   int repeat = 3;                              //Set by --repeat, the number of searches timed.
+   std::vector<const char*> orders = {"file"};  //Set by --order, the orders the Graph is frozen and searched in.
+   double fileSearch = 0;                       //The fastest search in the file order, which the others are compared to.
+   std::size_t resident = 0;
+   std::size_t peak = 0;
+   std::size_t entries = 0;                     //The entries the parsers found, so their work is not thrown away.
+   double megabytes;
+
+   if (argc < 2) {
+      std::cout << "Usage: Benchmark PATH [--threads N] [--repeat N] [--bipartite] [--center NAME] [--order NAME] [--compress] [--sorted]\n";
+      return 0;
+   }
+
+   //Options follow the file name.
+   for (int i = 2; i < argc; i++) {
+      //Every option has not been read yet.
+
+      std::string option = argv[i];
+      if (option == "--threads" && i + 1 < argc) {
+         threadCount = static_cast<unsigned>(std::max(1, std::atoi(argv[++i])));
+      }
+      else if (option == "--repeat" && i + 1 < argc) {
+         repeat = std::max(1, std::atoi(argv[++i]));
+      }
+      else if (option == "--bipartite") {
+         graph.SetBipartite(true);
+      }
+      else if (option == "--compress") {
+         graph.SetCompressed(true);
+      }
+      else if (option == "--sorted") {
+         graph.SetSortedOutput(true);
+      }
+      else if (option == "--center" && i + 1 < argc) {
+         graph.SetCenter(argv[++i]);
+      }
+      else if (option == "--order" && i + 1 < argc) {
+         Graph::VertexOrder order;
+
+         orders = {argv[++i]};
+         if (std::string(argv[i]) == "all") {
+            orders = {"file", "bfs", "degree", "rcm"};
+         }
+         else if (!Graph::OrderFromName(argv[i], order)) {
+            std::cout << "Unknown order " << argv[i] << ". The orders are file, bfs, degree, rcm and all.\n";
+            return 0;
+         }
+      }
+      else {
+         std::cout << "Unknown option " << option << ".\n";
+         return 0;
+      }
+   }
+   graph.SetThreadCount(threadCount);
+
+   //The parsers write over what they read, so each stage reading the file gets its own private mapping.
+   if (!parseFile.Open(argv[1]) || !file.Open(argv[1])) {
+      std::cout << "The file could not be opened.\n";
+      return 0;
+   }
+   megabytes = static_cast<double>(file.Size()) / (1 << 20);
+
+   //Parse alone, split the same way the loader splits the file.
+   {
+      std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+      std::vector<char*> starts = SplitActorList(parseFile.Data(), parseFile.Data() + parseFile.Size(), threadCount);
+      std::vector<std::size_t> chunkEntries(starts.size() - 1, 0);
+
+      ParallelFor(chunkEntries.size(), threadCount, [&starts, &chunkEntries](std::size_t first, std::size_t last, std::size_t) {
+         std::string_view name;
+         std::vector<std::string_view> movies;
+
+         for (std::size_t chunk = first; chunk < last; chunk++) {
+            //Every chunk of this thread has not been parsed yet.
+
+            ActorListParser parser(starts[chunk], starts[chunk + 1]);
+            while (parser.Next(name, movies)) {
+               //The chunk has more actor/actress entries.
+
+               chunkEntries[chunk]++;
+            }
+         }
+      });
+      for (std::size_t i : chunkEntries) {
+         //Every chunk's entries have not been counted yet.
+
+         entries += i;
+      }
+      double seconds = SecondsSince(start);
+      Report("parse", seconds, megabytes / seconds, "MB/s");
+   }
+   parseFile.Close();
+
+   {
+      std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+      LoadActorList(graph, file.Data(), file.Data() + file.Size(), threadCount);
+      double seconds = SecondsSince(start);
+      Report("load", seconds, megabytes / seconds, "MB/s");
+   }
+
+   for (const char* name : orders) {
+      //Every order has not been measured yet.
+
+      Graph::VertexOrder order;
+      std::uint32_t center;
+      std::string suffix = orders.size() == 1 ? std::string() : std::string(" ") + name;
+
+      Graph::OrderFromName(name, order);
+      graph.SetOrder(order);
+      {
+         std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+         graph.Finalize();
+         double seconds = SecondsSince(start);
+         Report(("build" + suffix).c_str(), seconds, static_cast<double>(graph.EdgeCount()) / seconds, "edges/s");
+      }
+      ResidentMemory(resident, peak);
+
+      //Without the center, the first actor/actress added is measured from so the searches are still timed.
+      center = graph.Find(graph.CenterName());
+      for (std::uint32_t id = 0; center == Graph::NoVertex && id < graph.VertexCount(); id++) {
+         //The first actor/actress added has not been found yet.
+
+         if (graph.AddedPosition(id) == 0) {
+            std::cout << graph.CenterName() << " is not in the file, so searches start from " << graph.NameOf(id) << ".\n";
+            center = id;
+         }
+      }
+      if (center == Graph::NoVertex) {
+         std::cout << "The file holds no actors/actresses.\n";
+         return 0;
+      }
+
+      {
+         double fastest = 0;
+
+         for (int i = 0; i < repeat; i++) {
+            //Every search has not been timed yet.
+
+            std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+            graph.ComputeDistances(center, scratch, threadCount, nullptr);
+            double seconds = SecondsSince(start);
+            fastest = i == 0 ? seconds : std::min(fastest, seconds);
+         }
+         Report(("search" + suffix).c_str(), fastest, static_cast<double>(graph.EdgeCount()) / fastest, "edges/s");
+
+         //Each order after the file order is compared to it.
+         if (order == Graph::VertexOrder::File) {
+            fileSearch = fastest;
+         }
+         else if (fileSearch != 0) {
+            std::cout << "speedup" << suffix << '\t' << fileSearch / fastest << "x over file\n";
+         }
+      }
+
+      {
+         CountingBuffer counter;
+         std::ostream out(&counter);
+         std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+         {
+            OutputWriter writer(out);
+            if (graph.SortedOutput()) {
+               graph.GenerateSortedNumbers(center, scratch, threadCount, writer);
+            }
+            else {
+               graph.GenerateNumbers(center, scratch, threadCount, writer);
+            }
+         }
+         double seconds = SecondsSince(start);
+         Report(("print" + suffix).c_str(), seconds, static_cast<double>(counter.count) / (1 << 20) / seconds, "MB/s");
+      }
+   }
+
+   std::cout << "memory\t" << static_cast<double>(resident) / (1 << 20) << " MB loaded\t" << static_cast<double>(peak) / (1 << 20)
+             << " MB peak\n";
+   std::cout << "rows\t" << static_cast<double>(graph.RowBytes()) / (1 << 20) << " MB\t"
+             << static_cast<double>(graph.RowBytes()) / std::max<std::size_t>(1, graph.EdgeCount()) << " bytes/edge\n";
+   std::cout << "graph\t" << entries << " entries\t" << graph.VertexCount() << " actors/actresses\t" << graph.MovieCount()
+             << " movies\t" << graph.EdgeCount() << " edges\n";
+   return 0;
+}
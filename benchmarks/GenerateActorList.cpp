@@ -0,0 +1,211 @@
+/*
+File Name:  GenerateActorList.cpp
+Author:     Logan Petersen
+Date:       Febuary 2, 2020
+Purpose:    The purpose of this code is to write a made up actors list in the IMDB format that
+            KevinBaconGame reads, of whatever size is needed to measure it. The same arguments and
+            seed always give the same file. It is built on its own, from the top of the repository:
+
+               g++ -std=c++17 -O2 -o GenerateActorList benchmarks/GenerateActorList.cpp OutputWriter.cpp
+
+            and run as
+
+               GenerateActorList PATH ACTORS [--movies N] [--credits MEAN] [--skew S] [--noise P] [--seed N]
+
+            ACTORS is the number of actors/actresses, from thousands to tens of millions. --movies is
+            the number of movies they share, half of ACTORS unless given. --credits is the average
+            number of movies each actor/actress is in, 4 unless given, with most in a few and some in
+            many. --skew shapes the casts: at 1 every movie is equally likely to be picked, and above 1
+            the first movies are picked far more often than the rest, giving a few casts in the
+            thousands as ensemble movies and long running shows have. It is 1.5 unless given. --noise
+            is the chance, 0.3 unless given, of each kind of extra information the parser must drop
+            being added to a credit: (TV) or (V) after the year, (uncredited) or (voice), and a billing
+            position in <>. Every credit ends with a role in [], as in the real lists. One of the
+            actors/actresses is Kevin Bacon, so the file can be given straight to KevinBaconGame.
+
+            Key variables are the settings read from the arguments, random, which picks everything,
+            and out, which the list is written through.
+*/
+
+#include "../OutputWriter.h" //Grants OutputWriter, which the list is written through.
+#include <fstream>           //Grants file writing, for the list.
+#include <iostream>          //Grants cout, for reporting what was written.
+#include <random>            //Grants mt19937_64 and the distributions that pick each credit.
+#include <string>            //Grants string, for reading the arguments.
+#include <vector>            //Grants the vector counting each movie's cast.
+#include <cmath>             //Grants pow, which skews the movies picked.
+#include <cstdlib>           //Grants strtoull and strtod, for reading the arguments.
+#include <cstdint>           //Grants the fixed width integers ids are made of.
+#include <algorithm>         //Grants max_element, for the largest cast.
+
+namespace {
+
+   //Words the movie names are made of.
+   const char* const TitleWords[] = {"The", "Night", "Return", "Love", "City", "Dark", "Last", "Story", "Man",
+                                     "Woman", "Blue", "House", "War", "Dream", "Road", "Summer", "Heart", "River"};
+   constexpr std::uint64_t TitleWordCount = sizeof(TitleWords) / sizeof(TitleWords[0]);
+
+   /*
+   Purpose:          Write a movie's name. The name depends on nothing but its id, so every credit for the movie
+                     names it the same way.
+   Parameters:       out, the writer the name is written through.
+                     movie, the movie's id.
+   Preconditions:    None.
+   Postconditions:   The name, with its year, has been written.
+   Return value:     None.
+   Functions Called: OutputWriter::Write() and OutputWriter::WriteNumber().
+   */
+   void WriteTitle(OutputWriter& out, std::uint64_t movie) {
+      std::uint64_t hash = (movie + 1) * 0x9E3779B97F4A7C15;
+      bool series = movie % 5 == 0; //One movie in five is a show, written in quotes with an episode.
+
+      if (series) {
+         out.Write('"');
+      }
+      for (std::uint64_t word = 0; word < 2 + hash % 3; word++) {
+         //Every word of the name has not been written yet.
+
+         out.Write(TitleWords[(hash >> (8 + 5 * word)) % TitleWordCount]);
+         out.Write(' ');
+      }
+      out.WriteNumber(static_cast<long long>(movie));
+      if (series) {
+         out.Write('"');
+      }
+      out.Write(" (");
+      out.WriteNumber(static_cast<long long>(1920 + (hash >> 40) % 100));
+      out.Write(')');
+      if (series) {
+         out.Write(" {Episode ");
+         out.WriteNumber(static_cast<long long>(hash % 200));
+         out.Write(" (#");
+         out.WriteNumber(static_cast<long long>(1 + hash % 9));
+         out.Write('.');
+         out.WriteNumber(static_cast<long long>(1 + hash % 22));
+         out.Write(")}");
+      }
+   }
+}
+
+int main(int argc, char** argv) {
+
+   //Local Variables
+   std::uint64_t actors;                 //The number of actors/actresses written.
+   std::uint64_t movies;                 //Set by --movies, the number of movies they share.
+   double creditMean = 4;                //Set by --credits, the average number of movies each is in.
+   double skew = 1.5;                    //Set by --skew, how strongly the first movies are favored.
+   double noise = 0.3;                   //Set by --noise, the chance of each kind of extra information.
+   std::uint64_t seed = 1;               //Set by --seed, which list of the given size is written.
+   std::uint64_t credits = 0;            //The number of credits written.
+   std::vector<std::uint32_t> castSizes; //The cast of each movie so far, to report the largest.
+
+   if (argc < 3) {
+      std::cout << "Usage: GenerateActorList PATH ACTORS [--movies N] [--credits MEAN] [--skew S] [--noise P] [--seed N]\n";
+      return 0;
+   }
+   actors = std::strtoull(argv[2], nullptr, 10);
+   movies = actors / 2;
+
+   //Options follow the path and the number of actors/actresses.
+   for (int i = 3; i < argc; i++) {
+      //Every option has not been read yet.
+
+      std::string option = argv[i];
+      if (option == "--movies" && i + 1 < argc) {
+         movies = std::strtoull(argv[++i], nullptr, 10);
+      }
+      else if (option == "--credits" && i + 1 < argc) {
+         creditMean = std::strtod(argv[++i], nullptr);
+      }
+      else if (option == "--skew" && i + 1 < argc) {
+         skew = std::strtod(argv[++i], nullptr);
+      }
+      else if (option == "--noise" && i + 1 < argc) {
+         noise = std::strtod(argv[++i], nullptr);
+      }
+      else if (option == "--seed" && i + 1 < argc) {
+         seed = std::strtoull(argv[++i], nullptr, 10);
+      }
+      else {
+         std::cout << "Unknown option " << option << ".\n";
+         return 0;
+      }
+   }
+   if (actors == 0 || movies == 0 || creditMean < 1 || skew < 1 || noise < 0 || noise > 1) {
+      std::cout << "ACTORS and --movies must be positive, --credits and --skew at least 1, and --noise from 0 to 1.\n";
+      return 0;
+   }
+
+   std::ofstream file(argv[1], std::ios::binary | std::ios::trunc);
+   if (!file) {
+      std::cout << "The file could not be opened.\n";
+      return 0;
+   }
+
+   {
+      OutputWriter out(file);
+      std::mt19937_64 random(seed);
+      std::uniform_real_distribution<double> chance(0, 1);
+      std::geometric_distribution<std::uint64_t> extraCredits(1 / creditMean); //Credits past the first, so the mean is creditMean.
+
+      castSizes.assign(movies, 0);
+      for (std::uint64_t actor = 0; actor < actors; actor++) {
+         //Every actor/actress has not been written yet.
+
+         std::uint64_t count = 1 + extraCredits(random);
+
+         if (actor == actors / 2) {
+            out.Write("Bacon, Kevin (I)");
+         }
+         else {
+            out.Write("Surname");
+            out.WriteNumber(static_cast<long long>(actor));
+            out.Write(", Given");
+            out.WriteNumber(static_cast<long long>(actor % 1009));
+            if (actor % 7 == 0) {
+               out.Write(" (II)");
+            }
+         }
+
+         for (std::uint64_t credit = 0; credit < count; credit++) {
+            //Every credit of this actor/actress has not been written yet.
+
+            //Raising the chance to skew crowds the picks toward the first movies.
+            std::uint64_t movie = static_cast<std::uint64_t>(static_cast<double>(movies) * std::pow(chance(random), skew));
+            if (movie >= movies) {
+               movie = movies - 1;
+            }
+            castSizes[movie]++;
+
+            out.Write(credit == 0 ? "\t" : "\t\t\t");
+            WriteTitle(out, movie);
+            if (chance(random) < noise) {
+               out.Write(chance(random) < 0.5 ? " (TV)" : " (V)");
+            }
+            if (chance(random) < noise) {
+               out.Write(chance(random) < 0.5 ? "  (uncredited)" : "  (voice)");
+            }
+            out.Write("  [Role ");
+            out.WriteNumber(static_cast<long long>(credit));
+            out.Write(']');
+            if (chance(random) < noise) {
+               out.Write("  <");
+               out.WriteNumber(static_cast<long long>(1 + credit));
+               out.Write('>');
+            }
+            out.Write('\n');
+         }
+         out.Write('\n');
+         credits += count;
+      }
+   }
+   file.close();
+   if (!file) {
+      std::cout << "The file could not be written.\n";
+      return 0;
+   }
+
+   std::cout << "Wrote " << actors << " actors/actresses with " << credits << " credits in " << movies
+             << " movies, the largest cast being " << *std::max_element(castSizes.begin(), castSizes.end()) << ".\n";
+   return 0;
+}